@@ -39,14 +39,26 @@
 // Include this file in your application to get everything
 //
 
+#include "iir/AdaptiveNotch.h"
+#include "iir/AnyFilter.h"
 #include "iir/Biquad.h"
+#include "iir/Block.h"
 #include "iir/Butterworth.h"
 #include "iir/Cascade.h"
 #include "iir/ChebyshevI.h"
 #include "iir/ChebyshevII.h"
 #include "iir/Common.h"
 #include "iir/Custom.h"
+#include "iir/CycleAccounting.h"
+#include "iir/Factory.h"
+#include "iir/FilterBank.h"
+#include "iir/Halfband.h"
+#include "iir/HarmonicNotch.h"
+#include "iir/Lattice.h"
+#include "iir/LinkwitzRiley.h"
+#include "iir/PCM.h"
 #include "iir/PoleFilter.h"
+#include "iir/Quantisation.h"
 #include "iir/RBJ.h"
 #include "iir/State.h"
 
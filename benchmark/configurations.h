@@ -0,0 +1,141 @@
+// Filter configurations which are benchmarked
+//
+// Every configuration filters blocks of float samples so that
+// all filter families and state types can be run by the same loop.
+//
+
+#ifndef IIR1_BENCHMARK_CONFIGURATIONS_H
+#define IIR1_BENCHMARK_CONFIGURATIONS_H
+
+#include "Iir.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Configuration {
+	// filter family and state type
+	std::string name;
+	// filters a block of n samples
+	std::function<void(const float* in, float* out, int n)> filter;
+	// clears the delay lines
+	std::function<void()> reset;
+};
+
+// Any filter with a block filter() and reset()
+template<class Filter>
+Configuration makeConfiguration(const std::string& name, std::shared_ptr<Filter> f)
+{
+	Configuration c;
+	c.name = name;
+	c.filter = [f](const float* in, float* out, int n) { f->filter(in, n, out); };
+	c.reset = [f]() { f->reset(); };
+	return c;
+}
+
+template<class StateType>
+void addButterworth(std::vector<Configuration>& configurations, double fs, const std::string& state)
+{
+	auto lp4 = std::make_shared<Iir::Butterworth::LowPass<4, StateType>>();
+	lp4->setup(fs, fs / 20);
+	configurations.push_back(makeConfiguration("Butterworth LowPass<4> " + state, lp4));
+	auto lp8 = std::make_shared<Iir::Butterworth::LowPass<8, StateType>>();
+	lp8->setup(fs, fs / 20);
+	configurations.push_back(makeConfiguration("Butterworth LowPass<8> " + state, lp8));
+}
+
+// All configurations at the sampling rate fs
+inline std::vector<Configuration> makeConfigurations(double fs)
+{
+	std::vector<Configuration> configurations;
+
+	addButterworth<Iir::DirectFormI>(configurations, fs, "DirectFormI");
+	addButterworth<Iir::DirectFormII>(configurations, fs, "DirectFormII");
+	addButterworth<Iir::TransposedDirectFormII>(configurations, fs, "TransposedDirectFormII");
+	addButterworth<Iir::StateVariableForm>(configurations, fs, "StateVariableForm");
+	addButterworth<Iir::CoupledForm>(configurations, fs, "CoupledForm");
+	addButterworth<Iir::StateVariableFormFloat>(configurations, fs, "StateVariableFormFloat");
+	addButterworth<Iir::CoupledFormFloat>(configurations, fs, "CoupledFormFloat");
+	addButterworth<Iir::LatticeLadder>(configurations, fs, "LatticeLadder");
+
+	auto cheby1 = std::make_shared<Iir::ChebyshevI::LowPass<8>>();
+	cheby1->setup(fs, fs / 20, 1);
+	configurations.push_back(makeConfiguration("ChebyshevI LowPass<8> DirectFormII", cheby1));
+
+	auto cheby2 = std::make_shared<Iir::ChebyshevII::BandStop<4>>();
+	cheby2->setup(fs, fs / 10, fs / 100, 40);
+	configurations.push_back(makeConfiguration("ChebyshevII BandStop<4> DirectFormII", cheby2));
+
+	auto notch = std::make_shared<Iir::RBJ::IIRNotch>();
+	notch->setup(fs, 50);
+	configurations.push_back(makeConfiguration("RBJ IIRNotch DirectFormI", notch));
+
+	// the coefficients of an 8th order Butterworth as SOS
+	Iir::Butterworth::LowPass<8> design;
+	design.setup(fs, fs / 20);
+	double sos[4][6];
+	for (int i = 0; i < 4; i++) {
+		const Iir::Biquad& b = design.getCascadeStorage().stageArray[i];
+		sos[i][0] = b.getB0();
+		sos[i][1] = b.getB1();
+		sos[i][2] = b.getB2();
+		sos[i][3] = b.getA0();
+		sos[i][4] = b.getA1();
+		sos[i][5] = b.getA2();
+	}
+	auto custom = std::make_shared<Iir::Custom::SOSCascade<4>>(sos);
+	configurations.push_back(makeConfiguration("Custom SOSCascade<4> DirectFormII", custom));
+
+	// 8 interleaved channels: the block size is per channel
+	const int channels = 8;
+	auto multi = std::make_shared<std::vector<Iir::Butterworth::LowPass<4>>>(channels);
+	auto interleaved = std::make_shared<std::vector<float>>();
+	for (auto& f : *multi) f.setup(fs, fs / 20);
+	Configuration mc;
+	mc.name = "Butterworth LowPass<4> x8 interleaved";
+	mc.filter = [multi, interleaved](const float* in, float* out, int n) {
+		if ((int)interleaved->size() < n * channels) interleaved->resize((size_t)(n * channels));
+		float* buffer = interleaved->data();
+		for (int i = 0; i < n; i++)
+			for (int c = 0; c < channels; c++) buffer[i * channels + c] = in[i];
+		Iir::filterInterleaved(multi->data(), channels, buffer, n, buffer);
+		for (int i = 0; i < n; i++) out[i] = buffer[i * channels];
+	};
+	mc.reset = [multi]() { for (auto& f : *multi) f.reset(); };
+	configurations.push_back(mc);
+
+	auto xover = std::make_shared<Iir::LinkwitzRiley::Crossover<3, 4>>();
+	auto bands = std::make_shared<std::vector<float>>();
+	const double fc[] = { fs / 100, fs / 10 };
+	xover->setup(fs, fc);
+	Configuration lr;
+	lr.name = "LinkwitzRiley Crossover<3, 4>";
+	lr.filter = [xover, bands](const float* in, float* out, int n) {
+		if ((int)bands->size() < 2 * n) bands->resize((size_t)(2 * n));
+		float* outputs[3] = { out, bands->data(), bands->data() + n };
+		xover->filter(in, n, outputs);
+	};
+	lr.reset = [xover]() { xover->reset(); };
+	configurations.push_back(lr);
+
+	auto decimator = std::make_shared<Iir::Halfband::Decimator<16>>();
+	decimator->setup(fs, fs / 12, 96);
+	configurations.push_back(makeConfiguration("Halfband Decimator<16>", decimator));
+
+	auto bank = std::make_shared<Iir::FilterBank<32, 3>>();
+	bank->setup(fs, 3, 25, fs / 4);
+	Configuration fb;
+	fb.name = "FilterBank<32, 3> third-octaves";
+	fb.filter = [bank](const float* in, float* out, int n) {
+		double energies[32];
+		bank->filter(in, n, (float* const*)nullptr, energies);
+		out[0] = (float)energies[0];
+	};
+	fb.reset = [bank]() { bank->reset(); };
+	configurations.push_back(fb);
+
+	return configurations;
+}
+
+#endif
@@ -0,0 +1,221 @@
+// Worst case latency / jitter of block filtering
+//
+// Runs every filter configuration with realistic block sizes on a
+// pinned thread and records the time of every single block call.
+// The percentiles p50/p99/p99.9 and the maximum are reported per
+// configuration and block size. A configuration is flagged if its
+// p99.9 (or with --tail max its maximum) exceeds the threshold and
+// the program then exits with 1.
+//
+// The input alternates between noise bursts and silence so that the
+// delay lines decay into the denormal range like with real audio.
+//
+// With --counters the hardware counters (Linux perf_event_open) of all
+// calls of a configuration are reported per sample as well.
+//
+
+#include "configurations.h"
+#include "perfcounters.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+static void usage()
+{
+	fprintf(stderr,
+		"Usage: iir_latency [options]\n"
+		"  --blocks 32,64,256    block sizes\n"
+		"  --calls N             block calls per configuration (10000)\n"
+		"  --warmup N            calls which are not recorded (10)\n"
+		"  --samplingrate FS     sampling rate (48000)\n"
+		"  --cpu N               pin to CPU N, -1: no pinning (0)\n"
+		"  --threshold-us T      flag configurations with a tail above T us (1000)\n"
+		"  --tail p999|max       percentile compared with the threshold (p999)\n"
+		"  --filter TEXT         only configurations containing TEXT\n"
+		"  --counters            report hardware counters (Linux)\n"
+		"  --raw-event HEX       additional raw counter, for example 0x1eca\n"
+		"                        (FP_ASSIST.ANY on Intel Skylake)\n"
+		"  --l2-event HEX        raw event of the L2 misses, 0 to disable\n"
+		"                        (default 0x3f24 on Intel, 0x0964 on AMD Zen)\n");
+}
+
+static std::vector<int> parseBlocks(const char* s)
+{
+	std::vector<int> blocks;
+	while (*s) {
+		const int b = atoi(s);
+		if (b > 0) blocks.push_back(b);
+		const char* comma = strchr(s, ',');
+		if (!comma) break;
+		s = comma + 1;
+	}
+	return blocks;
+}
+
+static bool pinThread(int cpu)
+{
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	(void)cpu;
+	return false;
+#endif
+}
+
+// one second of noise bursts followed by silence
+static std::vector<float> makeInput(double fs)
+{
+	std::vector<float> input((size_t)fs);
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> noise(-1, 1);
+	for (size_t i = 0; i < input.size(); i++)
+		input[i] = (i < input.size() / 4) ? noise(rng) : 0;
+	return input;
+}
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+	const size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+	return sorted[std::min(i, sorted.size() - 1)];
+}
+
+static void printCounter(const PerfCounters& perf, PerfCounters::Counter c, const char* name, double samples)
+{
+	if (perf.isAvailable(c))
+		printf("  %s/sample %.3f", name, (double)perf.get(c) / samples);
+	else
+		printf("  %s n/a", name);
+}
+
+static void printCounters(const PerfCounters& perf, double samples)
+{
+	printf("%-48s", "  counters:");
+	printCounter(perf, PerfCounters::cycles, "cycles", samples);
+	printCounter(perf, PerfCounters::instructions, "instructions", samples);
+	if (perf.isAvailable(PerfCounters::cycles) && perf.isAvailable(PerfCounters::instructions) &&
+		perf.get(PerfCounters::cycles))
+		printf("  IPC %.2f", (double)perf.get(PerfCounters::instructions) / (double)perf.get(PerfCounters::cycles));
+	printCounter(perf, PerfCounters::l1dMisses, "L1D-misses", samples);
+	printCounter(perf, PerfCounters::l2Misses, "L2-misses", samples);
+	printCounter(perf, PerfCounters::llcMisses, "LLC-misses", samples);
+	if (perf.isAvailable(PerfCounters::rawEvent))
+		printCounter(perf, PerfCounters::rawEvent, "raw-event", samples);
+	if (perf.getRunningFraction() == 0)
+		printf("  (not scheduled)");
+	else if (perf.getRunningFraction() < 1)
+		printf("  (scaled, counted %.0f%%)", perf.getRunningFraction() * 100);
+	printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<int> blocks = { 32, 64, 128, 256, 512 };
+	int calls = 10000;
+	int warmup = 10;
+	double fs = 48000;
+	int cpu = 0;
+	double threshold = 1000;
+	bool tailMax = false;
+	std::string only;
+	bool counters = false;
+	uint64_t rawEvent = 0;
+	uint64_t l2Event = PerfCounters::getDefaultL2Event();
+
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = (i + 1) < argc;
+		if (!strcmp(argv[i], "--blocks") && hasValue) blocks = parseBlocks(argv[++i]);
+		else if (!strcmp(argv[i], "--calls") && hasValue) calls = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--warmup") && hasValue) warmup = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--samplingrate") && hasValue) fs = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--cpu") && hasValue) cpu = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--threshold-us") && hasValue) threshold = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--tail") && hasValue) tailMax = !strcmp(argv[++i], "max");
+		else if (!strcmp(argv[i], "--filter") && hasValue) only = argv[++i];
+		else if (!strcmp(argv[i], "--counters")) counters = true;
+		else if (!strcmp(argv[i], "--raw-event") && hasValue) rawEvent = strtoull(argv[++i], nullptr, 16);
+		else if (!strcmp(argv[i], "--l2-event") && hasValue) l2Event = strtoull(argv[++i], nullptr, 16);
+		else {
+			usage();
+			return 2;
+		}
+	}
+	if (blocks.empty() || (calls < 1) || (warmup < 0) || (fs <= 0)) {
+		usage();
+		return 2;
+	}
+
+	if ((cpu >= 0) && !pinThread(cpu))
+		fprintf(stderr, "Could not pin the thread to CPU %d.\n", cpu);
+
+	const std::vector<float> input = makeInput(fs);
+	const int maxBlock = *std::max_element(blocks.begin(), blocks.end());
+	if (maxBlock >= (int)input.size()) {
+		fprintf(stderr, "Block size too large for the sampling rate.\n");
+		return 2;
+	}
+	std::vector<float> output((size_t)maxBlock);
+	std::vector<double> latencies((size_t)calls);
+	std::vector<Configuration> configurations = makeConfigurations(fs);
+
+	PerfCounters perf(rawEvent, l2Event);
+	if (counters && !perf.isAvailable()) {
+		fprintf(stderr, "Hardware counters are not available (perf_event_open failed).\n");
+		counters = false;
+	}
+
+	printf("%-48s %6s %10s %10s %10s %10s %10s\n",
+		"configuration", "block", "p50/us", "p99/us", "p99.9/us", "max/us", "ns/sample");
+	int flagged = 0;
+	for (auto& c : configurations) {
+		if (!only.empty() && (c.name.find(only) == std::string::npos)) continue;
+		for (int block : blocks) {
+			c.reset();
+			const size_t wrap = input.size() - (size_t)block;
+			size_t pos = 0;
+			for (int call = -warmup; call < calls; call++) {
+				if (counters && (call == 0)) perf.start();
+				const auto start = std::chrono::steady_clock::now();
+				c.filter(input.data() + pos, output.data(), block);
+				const auto stop = std::chrono::steady_clock::now();
+				if (call >= 0)
+					latencies[(size_t)call] =
+						std::chrono::duration<double, std::micro>(stop - start).count();
+				pos = (pos + (size_t)block) % wrap;
+			}
+			if (counters) perf.stop();
+			std::vector<double> sorted(latencies);
+			std::sort(sorted.begin(), sorted.end());
+			const double p50 = percentile(sorted, 0.5);
+			const double p99 = percentile(sorted, 0.99);
+			const double p999 = percentile(sorted, 0.999);
+			const double max = sorted.back();
+			const bool flag = (tailMax ? max : p999) > threshold;
+			if (flag) flagged++;
+			printf("%-48s %6d %10.3f %10.3f %10.3f %10.3f %10.3f%s\n",
+				c.name.c_str(), block, p50, p99, p999, max, p50 * 1000 / block,
+				flag ? "  !! tail above threshold" : "");
+			if (counters) printCounters(perf, (double)calls * block);
+		}
+	}
+
+	fflush(stdout);
+	if (flagged) {
+		fprintf(stderr, "%d configuration(s) above the threshold of %g us.\n", flagged, threshold);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,183 @@
+// Hardware performance counters via the Linux perf_event_open interface
+//
+// Counts cycles, instructions, L1 data cache read misses, L2 misses,
+// last level cache read misses and optionally a raw event such as the
+// floating point assists of denormals (for example 0x1eca: FP_ASSIST.ANY
+// on Intel Skylake, see the manual of the CPU). Only user space is counted.
+// The kernel has no generic L2 event so L2 misses are a raw event as well:
+// L2_RQSTS.MISS (0x3f24) on Intel and L2CacheReqStat IC/DC misses (0x0964)
+// on AMD Zen by default. Other CPUs need it to be passed in.
+// Counters which can't be opened (other OS, no permission, not
+// supported by the CPU) are reported as not available.
+//
+// All counters are opened as one group so that the kernel schedules them
+// together and ratios such as instructions per cycle are meaningful. The
+// group is read with its enabled and running times: if the kernel had to
+// multiplex it with other users of the PMU, the counts are scaled up to the
+// whole interval and getRunningFraction() is below one.
+//
+
+#ifndef IIR1_BENCHMARK_PERFCOUNTERS_H
+#define IIR1_BENCHMARK_PERFCOUNTERS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class PerfCounters {
+public:
+	enum Counter {
+		cycles,
+		instructions,
+		l1dMisses,
+		l2Misses,
+		llcMisses,
+		rawEvent,
+		numCounters
+	};
+
+	// rawEventCode: CPU specific event, 0 to disable
+	// l2EventCode: raw event of the L2 misses, 0 to disable
+	explicit PerfCounters(uint64_t rawEventCode = 0, uint64_t l2EventCode = getDefaultL2Event())
+		: m_leader(-1), m_runningFraction(0) {
+		for (int i = 0; i < numCounters; i++) {
+			m_fd[i] = -1;
+			m_values[i] = 0;
+		}
+#ifdef __linux__
+		m_fd[cycles] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+		m_fd[instructions] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+		m_fd[l1dMisses] = open(PERF_TYPE_HW_CACHE,
+			PERF_COUNT_HW_CACHE_L1D |
+			(PERF_COUNT_HW_CACHE_OP_READ << 8) |
+			(PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+		if (l2EventCode) m_fd[l2Misses] = open(PERF_TYPE_RAW, l2EventCode);
+		m_fd[llcMisses] = open(PERF_TYPE_HW_CACHE,
+			PERF_COUNT_HW_CACHE_LL |
+			(PERF_COUNT_HW_CACHE_OP_READ << 8) |
+			(PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+		if (rawEventCode) m_fd[rawEvent] = open(PERF_TYPE_RAW, rawEventCode);
+#else
+		(void)rawEventCode;
+		(void)l2EventCode;
+#endif
+	}
+
+	// raw L2 miss event of the CPU or 0 if it is not known
+	static uint64_t getDefaultL2Event() {
+#if defined(__x86_64__) || defined(__i386__)
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) return 0;
+		char vendor[13];
+		memcpy(vendor, &ebx, 4);
+		memcpy(vendor + 4, &edx, 4);
+		memcpy(vendor + 8, &ecx, 4);
+		vendor[12] = 0;
+		if (!strcmp(vendor, "GenuineIntel")) return 0x3f24;
+		if (!strcmp(vendor, "AuthenticAMD")) return 0x0964;
+#endif
+		return 0;
+	}
+
+	~PerfCounters() {
+#ifdef __linux__
+		// the members of the group before its leader
+		for (int i = numCounters - 1; i >= 0; i--)
+			if (m_fd[i] >= 0) close(m_fd[i]);
+#endif
+	}
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	// true if at least one counter could be opened
+	bool isAvailable() const {
+		for (int i = 0; i < numCounters; i++)
+			if (m_fd[i] >= 0) return true;
+		return false;
+	}
+
+	bool isAvailable(Counter c) const {
+		return m_fd[c] >= 0;
+	}
+
+	void start() {
+#ifdef __linux__
+		if (m_leader < 0) return;
+		ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+	}
+
+	void stop() {
+#ifdef __linux__
+		if (m_leader < 0) return;
+		ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		// nr, time enabled, time running and one value per member
+		uint64_t group[3 + numCounters] = {};
+		const ssize_t n = read(m_leader, group, sizeof(group));
+		const uint64_t enabled = group[1];
+		const uint64_t running = group[2];
+		m_runningFraction = ((n >= 3 * (ssize_t)sizeof(uint64_t)) && enabled) ?
+			(double)running / (double)enabled : 0;
+		int member = 0;
+		for (int i = 0; i < numCounters; i++) {
+			if (m_fd[i] < 0) continue;
+			const double value = (m_runningFraction > 0) ? (double)group[3 + member] : 0;
+			// extrapolated to the whole interval if the group was multiplexed
+			m_values[i] = (m_runningFraction > 0) ? (uint64_t)(value / m_runningFraction + 0.5) : 0;
+			member++;
+		}
+#endif
+	}
+
+	// value of the last start()/stop() interval
+	uint64_t get(Counter c) const {
+		return m_values[c];
+	}
+
+	// fraction of the last interval in which the group was counting:
+	// 1 without multiplexing, 0 if the kernel could not schedule the group
+	double getRunningFraction() const {
+		return m_runningFraction;
+	}
+
+private:
+#ifdef __linux__
+	// the first counter which can be opened becomes the leader of the group
+	int open(uint32_t type, uint64_t config) {
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = type;
+		attr.config = config;
+		// only the leader starts disabled, the members follow it
+		if (m_leader < 0) attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP |
+			PERF_FORMAT_TOTAL_TIME_ENABLED |
+			PERF_FORMAT_TOTAL_TIME_RUNNING;
+		const int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, m_leader, 0);
+		if ((fd >= 0) && (m_leader < 0)) m_leader = fd;
+		return fd;
+	}
+#endif
+
+	int m_fd[numCounters];
+	int m_leader;
+	uint64_t m_values[numCounters];
+	double m_runningFraction;
+};
+
+#endif
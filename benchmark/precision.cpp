@@ -0,0 +1,120 @@
+// Speed and accuracy of the reduced precision states
+//
+// Runs a Butterworth lowpass and an ECG baseline highpass with the
+// float states and compares them against DirectFormII in double
+// precision: the time per sample (best of several runs) and the RMS
+// error of the output relative to the RMS of the double output.
+//
+
+#include "Iir.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+static void usage()
+{
+	fprintf(stderr,
+		"Usage: iir_precision [options]\n"
+		"  --samples N        samples per measurement (1000000)\n");
+}
+
+struct Result {
+	double nsPerSample;
+	double error;
+};
+
+// runs one design with StateType against DirectFormII
+template<template<int, class> class Design, class StateType>
+Result run(double fs, double fc, const std::vector<double>& input)
+{
+	Design<4, StateType> f;
+	Design<4, Iir::DirectFormII> ref;
+	f.setup(fs, fc);
+	ref.setup(fs, fc);
+
+	const int n = (int)input.size();
+	std::vector<double> output(input.size());
+	std::vector<double> reference(input.size());
+	ref.filter(input.data(), n, reference.data());
+
+	Result r;
+	r.nsPerSample = 0;
+	for (int run = 0; run < 6; run++) {
+		f.reset();
+		const auto start = std::chrono::steady_clock::now();
+		f.filter(input.data(), n, output.data());
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / n;
+		// the first run warms up the caches
+		if ((run == 1) || ((run > 1) && (ns < r.nsPerSample))) r.nsPerSample = ns;
+	}
+
+	double sum = 0;
+	double sumRef = 0;
+	for (int i = 0; i < n; i++) {
+		sum += (output[i] - reference[i]) * (output[i] - reference[i]);
+		sumRef += reference[i] * reference[i];
+	}
+	r.error = sqrt(sum / sumRef);
+	return r;
+}
+
+template<template<int, class> class Design>
+void runAll(const char* name, double fs, double fc, const std::vector<double>& input)
+{
+	printf("%s, fc/fs = %g\n", name, fc / fs);
+	printf("%-30s %12s %14s\n", "state", "ns/sample", "rel. error");
+	const struct {
+		const char* name;
+		Result result;
+	} results[] = {
+		{ "DirectFormII", run<Design, Iir::DirectFormII>(fs, fc, input) },
+		{ "StateVariableFormFloat", run<Design, Iir::StateVariableFormFloat>(fs, fc, input) },
+		{ "CoupledFormFloat", run<Design, Iir::CoupledFormFloat>(fs, fc, input) },
+		{ "StateVariableForm", run<Design, Iir::StateVariableForm>(fs, fc, input) },
+		{ "CoupledForm", run<Design, Iir::CoupledForm>(fs, fc, input) },
+	};
+	for (const auto& r : results) {
+		printf("%-30s %12.2f %14.3e\n", r.name, r.result.nsPerSample, r.result.error);
+	}
+	printf("\n");
+}
+
+template<int Order, class StateType>
+using LowPass = Iir::Butterworth::LowPass<Order, StateType>;
+
+template<int Order, class StateType>
+using HighPass = Iir::Butterworth::HighPass<Order, StateType>;
+
+int main(int argc, char** argv)
+{
+	int samples = 1000000;
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = (i + 1) < argc;
+		if (!strcmp(argv[i], "--samples") && hasValue) samples = atoi(argv[++i]);
+		else {
+			usage();
+			return 2;
+		}
+	}
+	if (samples < 1) {
+		usage();
+		return 2;
+	}
+
+	// noise with a slow drift which is what a baseline filter removes
+	std::vector<double> input((size_t)samples);
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<double> noise(-0.5, 0.5);
+	for (int i = 0; i < samples; i++) input[(size_t)i] = noise(rng) + sin(0.0005 * i) + 0.1;
+
+	runAll<LowPass>("Butterworth LowPass<4>", 48000, 2400, input);
+	runAll<HighPass>("Butterworth HighPass<4> (ECG baseline)", 1000, 0.1, input);
+	return 0;
+}
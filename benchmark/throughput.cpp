@@ -0,0 +1,153 @@
+// Throughput regression test
+//
+// Measures the throughput (ns/sample) of one filter configuration and
+// compares it against a local baseline file. The test fails (exit 1) if
+// the kernel got slower than the baseline by more than the tolerance.
+// If the baseline file has no entry for the configuration (or with
+// --update) the measured value is stored as the new baseline.
+//
+// The baseline file has one line per configuration:
+// <ns/sample> <configuration name>
+//
+
+#include "configurations.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static void usage()
+{
+	fprintf(stderr,
+		"Usage: iir_throughput --kernel NAME --baseline FILE [options]\n"
+		"  --tolerance T      allowed slowdown as a fraction (0.25)\n"
+		"  --update           store the measured value as the new baseline\n"
+		"  --samples N        samples per measurement (2000000)\n"
+		"  --block N          block size (256)\n"
+		"  --list             list the configurations\n");
+}
+
+static std::map<std::string, double> readBaseline(const std::string& filename)
+{
+	std::map<std::string, double> baseline;
+	std::ifstream f(filename.c_str());
+	std::string line;
+	while (std::getline(f, line)) {
+		std::istringstream l(line);
+		double value;
+		std::string name;
+		if (!(l >> value)) continue;
+		std::getline(l >> std::ws, name);
+		if (!name.empty()) baseline[name] = value;
+	}
+	return baseline;
+}
+
+static bool writeBaseline(const std::string& filename, const std::map<std::string, double>& baseline)
+{
+	std::ofstream f(filename.c_str());
+	for (const auto& b : baseline) f << b.second << " " << b.first << "\n";
+	return f.good();
+}
+
+// best of several runs in ns/sample
+static double measure(Configuration& c, int samples, int block)
+{
+	std::vector<float> input((size_t)block * 64);
+	std::vector<float> output((size_t)block);
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> noise(-1, 1);
+	for (auto& x : input) x = noise(rng);
+
+	const int calls = std::max(1, samples / block);
+	double best = 0;
+	for (int run = 0; run < 11; run++) {
+		c.reset();
+		size_t pos = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (int call = 0; call < calls; call++) {
+			c.filter(input.data() + pos, output.data(), block);
+			pos = (pos + (size_t)block) % input.size();
+		}
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / ((double)calls * block);
+		// the first run warms up the caches
+		if ((run == 1) || ((run > 1) && (ns < best))) best = ns;
+	}
+	return best;
+}
+
+int main(int argc, char** argv)
+{
+	std::string kernel;
+	std::string baselineFile;
+	double tolerance = 0.25;
+	bool update = false;
+	bool list = false;
+	int samples = 2000000;
+	int block = 256;
+
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = (i + 1) < argc;
+		if (!strcmp(argv[i], "--kernel") && hasValue) kernel = argv[++i];
+		else if (!strcmp(argv[i], "--baseline") && hasValue) baselineFile = argv[++i];
+		else if (!strcmp(argv[i], "--tolerance") && hasValue) tolerance = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--samples") && hasValue) samples = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--block") && hasValue) block = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--update")) update = true;
+		else if (!strcmp(argv[i], "--list")) list = true;
+		else {
+			usage();
+			return 2;
+		}
+	}
+
+	std::vector<Configuration> configurations = makeConfigurations(48000);
+	if (list) {
+		for (const auto& c : configurations) printf("%s\n", c.name.c_str());
+		return 0;
+	}
+	if (kernel.empty() || baselineFile.empty() || (samples < 1) || (block < 1) || (tolerance < 0)) {
+		usage();
+		return 2;
+	}
+
+	auto c = std::find_if(configurations.begin(), configurations.end(),
+		[&kernel](const Configuration& x) { return x.name == kernel; });
+	if (c == configurations.end()) {
+		fprintf(stderr, "Unknown configuration: %s\n", kernel.c_str());
+		return 2;
+	}
+
+	const double ns = measure(*c, samples, block);
+	std::map<std::string, double> baseline = readBaseline(baselineFile);
+	const auto b = baseline.find(kernel);
+	if (update || (b == baseline.end())) {
+		baseline[kernel] = ns;
+		if (!writeBaseline(baselineFile, baseline)) {
+			fprintf(stderr, "Could not write the baseline file %s.\n", baselineFile.c_str());
+			return 2;
+		}
+		printf("%s: %.3f ns/sample (new baseline)\n", kernel.c_str(), ns);
+		return 0;
+	}
+
+	const double change = ns / b->second - 1;
+	printf("%s: %.3f ns/sample, baseline %.3f ns/sample (%+.1f%%)\n",
+		kernel.c_str(), ns, b->second, change * 100);
+	if (change > tolerance) {
+		fprintf(stderr, "Regression: %s is %.1f%% slower than the baseline (tolerance %.1f%%).\n",
+			kernel.c_str(), change * 100, tolerance * 100);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "AdaptiveNotch.h"
+
+#include "Common.h"
+
+namespace Iir {
+
+  AdaptiveNotchBase::AdaptiveNotchBase()
+      : m_rho(0),
+        m_rho2(0),
+        m_c(-2),
+        m_c0(-2),
+        m_cMin(-2),
+        m_cMax(2),
+        m_rate(0),
+        m_power(0),
+        m_powerSmoothing(0),
+        m_sampleRate(1),
+        m_adaptive(true) {}
+
+  void AdaptiveNotchBase::setupBase(double centerFrequency,
+                                    double bandwidth,
+                                    double maxDeviation,
+                                    double adaptationRate,
+                                    double sampleRate) {
+    if ((centerFrequency <= 0) || (centerFrequency >= 0.5))
+      throw std::invalid_argument("The centre frequency needs to be between 0 and Nyquist.");
+    if ((bandwidth <= 0) || (bandwidth >= 0.5))
+      throw std::invalid_argument("The bandwidth of the notch needs to be between 0 and Nyquist.");
+    if (maxDeviation < 0)
+      throw std::invalid_argument("The maximum deviation cannot be negative.");
+    if ((adaptationRate < 0) || (adaptationRate > 1))
+      throw std::invalid_argument("The adaptation rate needs to be between 0 and 1.");
+
+    const double lower = std::max(centerFrequency - maxDeviation, 0.);
+    const double upper = std::min(centerFrequency + maxDeviation, 0.5);
+
+    m_rho            = exp(-doublePi * bandwidth);
+    m_rho2           = m_rho * m_rho;
+    m_c0             = -2 * cos(2 * doublePi * centerFrequency);
+    m_cMin           = -2 * cos(2 * doublePi * lower);
+    m_cMax           = -2 * cos(2 * doublePi * upper);
+    m_rate           = adaptationRate;
+    // the input power is averaged over about the length of the notch response
+    m_powerSmoothing = m_rho;
+    m_sampleRate     = sampleRate;
+    resetBase();
+  }
+
+  void AdaptiveNotchBase::resetBase() {
+    m_c     = m_c0;
+    m_power = 0;
+  }
+
+  double AdaptiveNotchBase::getNormalisedFrequency() const {
+    return acos(-m_c / 2) / (2 * doublePi);
+  }
+
+}  // namespace Iir
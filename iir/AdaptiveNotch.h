@@ -0,0 +1,261 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_ADAPTIVENOTCH_H
+#define IIR1_ADAPTIVENOTCH_H
+
+#include "Common.h"
+#include "MathSupplement.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Iir {
+
+  /**
+   * Coefficients and adaptation of the AdaptiveNotch which do not
+   * depend on the number of channels.
+   * The notch has the transfer function
+   * H(z) = (1 + c z^-1 + z^-2) / (1 + rho c z^-1 + rho^2 z^-2)
+   * with c = -2 cos(w0) so that b1 = c and a1 = rho c. The centre
+   * frequency is tracked by a normalised LMS rule directly on c which
+   * minimises the output power. Its gradient is the regressor filtered
+   * by the poles of the notch so that only the signal around the notch
+   * steers the adaptation. No trigonometric functions are evaluated
+   * while adapting.
+   **/
+  class DllExport AdaptiveNotchBase {
+  public:
+    /**
+     * Returns the current normalised centre frequency (0..1/2).
+     * This evaluates an acos() so it should only be called for monitoring.
+     **/
+    double getNormalisedFrequency() const;
+
+    /**
+     * Returns the current centre frequency in Hz
+     **/
+    double getFrequency() const {
+      return getNormalisedFrequency() * m_sampleRate;
+    }
+
+    /**
+     * Returns the current coefficient c = -2 cos(w0) which is b1 of the notch
+     **/
+    double getCoefficient() const {
+      return m_c;
+    }
+
+    /**
+     * Switches the adaptation on or off. When off the notch stays at
+     * its current frequency.
+     **/
+    void setAdaptive(bool adaptive) {
+      m_adaptive = adaptive;
+    }
+
+  protected:
+    AdaptiveNotchBase();
+
+    /**
+     * Sets up the notch with normalised frequencies
+     * \param centerFrequency Initial centre frequency (0..1/2)
+     * \param bandwidth -3dB width of the notch
+     * \param maxDeviation Largest distance of the tracked frequency from centerFrequency
+     * \param adaptationRate Step size of the normalised LMS (0..1), e.g. 0.005
+     * \param sampleRate Sampling rate which is only used by getFrequency()
+     **/
+    void setupBase(double centerFrequency,
+                   double bandwidth,
+                   double maxDeviation,
+                   double adaptationRate,
+                   double sampleRate);
+
+    // moves the centre frequency after one frame
+    inline void adapt(const double gradient, const double power) {
+      if (!m_adaptive) return;
+      m_power = m_powerSmoothing * m_power + (1 - m_powerSmoothing) * power;
+      m_c -= m_rate * gradient / (m_power + 1E-30);
+      if (m_c < m_cMin) m_c = m_cMin;
+      if (m_c > m_cMax) m_c = m_cMax;
+    }
+
+    void resetBase();
+
+    double m_rho;
+    double m_rho2;
+    double m_c;
+
+  private:
+    double m_c0;
+    double m_cMin;
+    double m_cMax;
+    double m_rate;
+    double m_power;
+    double m_powerSmoothing;
+    double m_sampleRate;
+    bool   m_adaptive;
+  };
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Notch filter which follows a drifting interference such as mains hum.
+   * All channels share one centre frequency because they are disturbed by
+   * the same source: the gradients of all channels are combined and the
+   * frequency is updated once per frame. This is much cheaper than
+   * estimating the frequency separately and calling RBJ::IIRNotch::setup()
+   * for every block.
+   * For unrelated signals use one AdaptiveNotch per channel.
+   * \param Channels Number of channels
+   **/
+  template<unsigned int Channels = 1>
+  class DllExport AdaptiveNotch : public AdaptiveNotchBase {
+    static_assert(Channels > 0, "The notch needs at least one channel.");
+
+  public:
+    AdaptiveNotch() {
+      reset();
+    }
+
+    /**
+     * Sets up the notch
+     * \param sampleRate Sampling rate
+     * \param centerFrequency Initial centre frequency, for example 50 or 60
+     * \param bandwidth -3dB width of the notch
+     * \param maxDeviation Largest distance of the tracked frequency from centerFrequency
+     * \param adaptationRate Step size of the normalised LMS (0..1)
+     **/
+    void setup(double sampleRate,
+               double centerFrequency,
+               double bandwidth,
+               double maxDeviation,
+               double adaptationRate = 0.005) {
+      setupBase(centerFrequency / sampleRate,
+                bandwidth / sampleRate,
+                maxDeviation / sampleRate,
+                adaptationRate,
+                sampleRate);
+      reset();
+    }
+
+    /**
+     * Sets up the notch with normalised frequencies (0..1/2)
+     * \param centerFrequency Initial centre frequency
+     * \param bandwidth -3dB width of the notch
+     * \param maxDeviation Largest distance of the tracked frequency from centerFrequency
+     * \param adaptationRate Step size of the normalised LMS (0..1)
+     **/
+    void setupN(double centerFrequency,
+                double bandwidth,
+                double maxDeviation,
+                double adaptationRate = 0.005) {
+      setupBase(centerFrequency, bandwidth, maxDeviation, adaptationRate, 1);
+      reset();
+    }
+
+    /**
+     * Clears the delay lines and returns to the initial centre frequency
+     **/
+    void reset() {
+      resetBase();
+      for (unsigned int ch = 0; ch < Channels; ch++) {
+        m_x1[ch] = 0;
+        m_x2[ch] = 0;
+        m_y1[ch] = 0;
+        m_y2[ch] = 0;
+        m_g1[ch] = 0;
+        m_g2[ch] = 0;
+      }
+    }
+
+    /**
+     * Filters one sample of a single channel notch
+     * \param in Sample to be filtered
+     **/
+    template<typename Sample>
+    inline Sample filter(const Sample in) {
+      static_assert(Channels == 1, "Provide a frame with one sample per channel.");
+      Sample out;
+      filter(&in, 1, &out);
+      return out;
+    }
+
+    /**
+     * Filters a block of interleaved frames with one sample per channel.
+     * The centre frequency is updated after every frame.
+     * \param in Input frames
+     * \param numFrames Number of frames
+     * \param out Output frames (can be the same as in)
+     **/
+    template<typename Sample>
+    void filter(const Sample* in, int numFrames, Sample* out) {
+      for (int i = 0; i < numFrames; i++) {
+        const double c        = m_c;
+        const double a1       = m_rho * c;
+        double       gradient = 0;
+        double       power    = 0;
+        for (unsigned int ch = 0; ch < Channels; ch++) {
+          const double x = static_cast<double>(*in++);
+          const double y = x + c * m_x1[ch] + m_x2[ch] - a1 * m_y1[ch] - m_rho2 * m_y2[ch];
+          // derivative of y with respect to c which is the
+          // regressor x[n-1] - rho y[n-1] through the poles of the notch
+          const double g = m_x1[ch] - m_rho * m_y1[ch] - a1 * m_g1[ch] - m_rho2 * m_g2[ch];
+          gradient += y * g;
+          power += g * g;
+          m_g2[ch] = m_g1[ch];
+          m_g1[ch] = g;
+          m_x2[ch] = m_x1[ch];
+          m_x1[ch] = x;
+          m_y2[ch] = m_y1[ch];
+          m_y1[ch] = y;
+          *out++   = static_cast<Sample>(y);
+        }
+        adapt(gradient, power);
+      }
+    }
+
+  private:
+    double m_x1[Channels];
+    double m_x2[Channels];
+    double m_y1[Channels];
+    double m_y2[Channels];
+    double m_g1[Channels];
+    double m_g2[Channels];
+  };
+
+}  // namespace Iir
+
+#endif
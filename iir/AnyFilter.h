@@ -0,0 +1,339 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_ANYFILTER_H
+#define IIR1_ANYFILTER_H
+
+#include "Common.h"
+#include "Types.h"
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Iir {
+
+  /**
+   * Holds any filter with one input and one output (Butterworth, Chebyshev,
+   * RBJ, SOSCascade, ...) whose type is only known at runtime, for example
+   * when it is chosen by a configuration file.
+   * The filter is stored by value: filters up to BufferSize bytes live inside
+   * the handle and only larger ones are allocated on the heap. The block
+   * filter() is dispatched once per block to the block kernel of the concrete
+   * filter so that the inner loop is the same as calling the filter directly.
+   **/
+  class DllExport AnyFilter {
+  public:
+    /**
+     * Filters up to this size are stored without a heap allocation. This
+     * covers for example an 8th order Butterworth bandpass.
+     **/
+    static const unsigned int BufferSize = 1536;
+
+    /**
+     * Creates an empty handle
+     **/
+    AnyFilter() : m_model(nullptr) {}
+
+    /**
+     * Stores a copy of a filter
+     * \param filter Any filter with a block filter() and reset()
+     **/
+    template<class Filter,
+             class = typename std::enable_if<
+                 !std::is_same<typename std::decay<Filter>::type, AnyFilter>::value>::type>
+    AnyFilter(Filter&& filter) : m_model(nullptr) {
+      emplace<typename std::decay<Filter>::type>(std::forward<Filter>(filter));
+    }
+
+    AnyFilter(const AnyFilter& other) : m_model(nullptr) {
+      if (other.m_model) m_model = other.m_model->copyTo(m_buffer);
+    }
+
+    // moving a filter into the buffer copies it without allocating so that
+    // containers such as std::vector move and do not copy when they grow
+    AnyFilter(AnyFilter&& other) noexcept : m_model(nullptr) {
+      take(other);
+    }
+
+    AnyFilter& operator=(const AnyFilter& other) {
+      if (this != &other) {
+        AnyFilter copy(other);
+        clear();
+        take(copy);
+      }
+      return *this;
+    }
+
+    AnyFilter& operator=(AnyFilter&& other) noexcept {
+      if (this != &other) {
+        clear();
+        take(other);
+      }
+      return *this;
+    }
+
+    ~AnyFilter() {
+      clear();
+    }
+
+    /**
+     * Constructs a filter in place and returns it so that it can be set up.
+     * \param args Arguments of the constructor of the filter
+     **/
+    template<class Filter, class... Args>
+    Filter& emplace(Args&&... args) {
+      clear();
+      Model<Filter>* model = Model<Filter>::create(m_buffer, std::forward<Args>(args)...);
+      m_model              = model;
+      return model->m_filter;
+    }
+
+    /**
+     * Returns a pointer to the stored filter if it is of the type Filter
+     * and nullptr otherwise.
+     **/
+    template<class Filter>
+    Filter* get() {
+      if (!m_model || (m_model->type() != typeId<Filter>())) return nullptr;
+      return &static_cast<Model<Filter>*>(m_model)->m_filter;
+    }
+
+    template<class Filter>
+    const Filter* get() const {
+      return const_cast<AnyFilter*>(this)->get<Filter>();
+    }
+
+    /**
+     * Returns true if no filter is stored
+     **/
+    bool empty() const {
+      return m_model == nullptr;
+    }
+
+    /**
+     * Returns true if the stored filter was too large for the buffer
+     **/
+    bool isOnHeap() const {
+      return m_model && (static_cast<const void*>(m_model) != static_cast<const void*>(m_buffer));
+    }
+
+    /**
+     * Removes the stored filter
+     **/
+    void clear() {
+      if (m_model) m_model->destroy();
+      m_model = nullptr;
+    }
+
+    /**
+     * Resets the delay lines of the stored filter
+     **/
+    void reset() {
+      model().reset();
+    }
+
+    /**
+     * Filters one sample. This is one indirect call per sample so
+     * the block filter() should be used whenever possible.
+     * \param in Sample to be filtered
+     **/
+    double filter(double in) {
+      return model().filter(in);
+    }
+
+    /**
+     * Filters a block of samples with one indirect call for the whole block.
+     * \param in Input samples
+     * \param n Number of samples
+     * \param out Output samples (can be the same as in)
+     * \param inStride Distance between two input samples
+     * \param outStride Distance between two output samples
+     **/
+    void filter(const double* in, int n, double* out, int inStride = 1, int outStride = 1) {
+      model().filter(in, n, out, inStride, outStride);
+    }
+
+    void filter(const float* in, int n, float* out, int inStride = 1, int outStride = 1) {
+      model().filter(in, n, out, inStride, outStride);
+    }
+
+    /**
+     * Returns true if the stored filter can calculate its response
+     **/
+    bool hasResponse() const {
+      return model().hasResponse();
+    }
+
+    /**
+     * Calculates the response of the stored filter
+     * \param normalizedFrequency Frequency from 0 to 0.5 (Nyquist)
+     **/
+    complex_t response(double normalizedFrequency) const {
+      return model().response(normalizedFrequency);
+    }
+
+  private:
+    // the filter interface which is dispatched at runtime
+    struct Concept {
+      virtual ~Concept() {}
+      virtual Concept*    copyTo(void* buffer) const = 0;
+      virtual Concept*    moveTo(void* buffer) noexcept = 0;
+      virtual void        destroy() = 0;
+      virtual const void* type() const = 0;
+      virtual void        reset() = 0;
+      virtual double      filter(double in) = 0;
+      virtual void        filter(const double* in, int n, double* out, int is, int os) = 0;
+      virtual void        filter(const float* in, int n, float* out, int is, int os) = 0;
+      virtual bool        hasResponse() const = 0;
+      virtual complex_t   response(double normalizedFrequency) const = 0;
+    };
+
+    // the concrete filter which is either placed in the buffer or on the heap
+    template<class Filter>
+    struct Model : Concept {
+      template<class... Args>
+      explicit Model(Args&&... args) : m_filter(std::forward<Args>(args)...) {}
+
+      static bool inBuffer() {
+        return (sizeof(Model) <= BufferSize) && (alignof(Model) <= alignof(std::max_align_t));
+      }
+
+      template<class... Args>
+      static Model* create(void* buffer, Args&&... args) {
+        if (inBuffer()) return new (buffer) Model(std::forward<Args>(args)...);
+        return new Model(std::forward<Args>(args)...);
+      }
+
+      Concept* copyTo(void* buffer) const override {
+        return create(buffer, m_filter);
+      }
+
+      Concept* moveTo(void* buffer) noexcept override {
+        return create(buffer, std::move(m_filter));
+      }
+
+      void destroy() override {
+        if (inBuffer())
+          this->~Model();
+        else
+          delete this;
+      }
+
+      const void* type() const override {
+        return typeId<Filter>();
+      }
+
+      void reset() override {
+        m_filter.reset();
+      }
+
+      double filter(double in) override {
+        return m_filter.filter(in);
+      }
+
+      void filter(const double* in, int n, double* out, int is, int os) override {
+        m_filter.filter(in, n, out, is, os);
+      }
+
+      void filter(const float* in, int n, float* out, int is, int os) override {
+        m_filter.filter(in, n, out, is, os);
+      }
+
+      bool hasResponse() const override {
+        return hasResponseOf(m_filter, 0);
+      }
+
+      complex_t response(double normalizedFrequency) const override {
+        return responseOf(m_filter, normalizedFrequency, 0);
+      }
+
+      Filter m_filter;
+    };
+
+    // response() is only called if the filter provides one
+    template<class Filter>
+    static auto hasResponseOf(const Filter& f, int) -> decltype(f.response(0.), bool()) {
+      return true;
+    }
+
+    template<class Filter>
+    static bool hasResponseOf(const Filter&, long) {
+      return false;
+    }
+
+    template<class Filter>
+    static auto responseOf(const Filter& f, double normalizedFrequency, int)
+        -> decltype(complex_t(f.response(normalizedFrequency))) {
+      return f.response(normalizedFrequency);
+    }
+
+    template<class Filter>
+    static complex_t responseOf(const Filter&, double, long) {
+      throw std::invalid_argument("The filter has no response().");
+    }
+
+    // one address per filter type which identifies it without RTTI
+    template<class Filter>
+    static const void* typeId() {
+      static const char id = 0;
+      return &id;
+    }
+
+    Concept& model() const {
+      if (!m_model) throw std::invalid_argument("The AnyFilter is empty.");
+      return *m_model;
+    }
+
+    void take(AnyFilter& other) noexcept {
+      if (!other.m_model) return;
+      if (other.isOnHeap()) {
+        m_model = other.m_model;
+      } else {
+        m_model = other.m_model->moveTo(m_buffer);
+        other.m_model->destroy();
+      }
+      other.m_model = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char m_buffer[BufferSize];
+    Concept* m_model;
+  };
+
+}  // namespace Iir
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_BLOCK_H
+#define IIR1_BLOCK_H
+
+#include "Common.h"
+
+namespace Iir {
+
+  /**
+   * Statistics of the output of one block which are accumulated
+   * by the block filter() methods while filtering. An empty block
+   * has all values zero, the same as a new object.
+   **/
+  struct DllExport BlockStatistics {
+    /// largest absolute value
+    double peak = 0;
+    /// sum of the squared samples
+    double sumOfSquares = 0;
+    /// smallest value
+    double min = 0;
+    /// largest value
+    double max = 0;
+    /// number of samples
+    int numSamples = 0;
+
+    /**
+     * Clears the statistics for a new block
+     **/
+    void reset() {
+      peak         = 0;
+      sumOfSquares = 0;
+      min          = 0;
+      max          = 0;
+      numSamples   = 0;
+    }
+
+    /**
+     * Adds one sample to the statistics
+     **/
+    inline void add(const double y) {
+      const double a = fabs(y);
+      if (a > peak) peak = a;
+      if ((y < min) || (numSamples == 0)) min = y;
+      if ((y > max) || (numSamples == 0)) max = y;
+      sumOfSquares += y * y;
+      numSamples++;
+    }
+
+    /**
+     * Returns the root mean square of the block
+     **/
+    double getRMS() const {
+      if (numSamples == 0) return 0;
+      return sqrt(sumOfSquares / numSamples);
+    }
+  };
+
+  /**
+   * Affine transform of the input and dry/wet mix of the output which
+   * are applied by the block filter() methods in the filter loop:
+   *
+   *  u[n]   = inputGain * x[n] + inputOffset
+   *  out[n] = wetGain * H(u)[n] + dryGain * u[n]
+   *
+   * For example inputOffset = -2250 removes the baseline of an ADC.
+   **/
+  struct DllExport BlockMix {
+    /// gain of the input
+    double inputGain = 1;
+    /// offset added to the input after the gain
+    double inputOffset = 0;
+    /// gain of the filtered signal
+    double wetGain = 1;
+    /// gain of the unfiltered (but transformed) input
+    double dryGain = 0;
+
+    /**
+     * Applies gain and offset to an input sample
+     **/
+    inline double transform(const double x) const {
+      return inputGain * x + inputOffset;
+    }
+
+    /**
+     * Mixes the filtered and the transformed input sample
+     **/
+    inline double mix(const double u, const double y) const {
+      return wetGain * y + dryGain * u;
+    }
+  };
+
+  /**
+   * Filters an interleaved buffer of numChannels channels with
+   * one filter per channel. Channel c is read from in[c],
+   * in[c+numChannels], ... and written to the same positions
+   * of out so that no de-interleaving is needed. The filtering
+   * can be in-place (in == out).
+   * \param filters Array of numChannels filters with a block filter() method
+   * \param numChannels Number of interleaved channels
+   * \param in Interleaved input frames
+   * \param numFrames Number of frames (samples per channel)
+   * \param out Interleaved output frames
+   **/
+  template<class Filter, typename Sample>
+  void filterInterleaved(Filter* filters, int numChannels, const Sample* in, int numFrames, Sample* out) {
+    for (int c = 0; c < numChannels; c++)
+      filters[c].filter(in + c, numFrames, out + c, numChannels, numChannels);
+  }
+
+}  // namespace Iir
+
+#endif
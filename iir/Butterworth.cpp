@@ -68,20 +68,29 @@ namespace Iir { namespace Butterworth {
 
   void AnalogLowShelf::design(int numPoles, double gainDb) {
     if (m_numPoles != numPoles || m_gainDb != gainDb) {
+      const double n2 = numPoles * 2;
+
+      // the angles doublePi * (0.5 - (2 * i - 1) / n2) by rotation, only
+      // calculated again when the order changes
+      if (m_numPoles != numPoles) {
+        m_rotation   = std::polar(1., -2 * doublePi / n2);
+        m_firstAngle = std::polar(1., doublePi * (0.5 - 1 / n2));
+      }
+
       m_numPoles = numPoles;
       m_gainDb   = gainDb;
 
       reset();
 
-      const double n2 = numPoles * 2;
-      const double g  = pow(pow(10., gainDb / 20), 1. / n2);
+      const double g  = exp(gainDb * doubleLn10 / (20 * n2));
       const double gp = -1. / g;
       const double gz = -g;
 
+      complex_t d     = m_firstAngle;
       const int pairs = numPoles / 2;
       for (int i = 1; i <= pairs; ++i) {
-        const double theta = doublePi * (0.5 - (2 * i - 1) / n2);
-        addPoleZeroConjugatePairs(std::polar(gp, theta), std::polar(gz, theta));
+        addPoleZeroConjugatePairs(gp * d, gz * d);
+        d *= m_rotation;
       }
 
       if (numPoles & 1) add(gp, gz);
@@ -123,31 +132,76 @@ namespace Iir { namespace Butterworth {
   }
 
   void LowShelfBase::setup(int order, double cutoffFrequency, double gainDb) {
+    m_transform.setup(cutoffFrequency);
+    m_order = order;
+
     m_analogProto.design(order, gainDb);
 
-    LowPassTransform(cutoffFrequency, m_digitalProto, m_analogProto);
+    m_transform.apply(m_digitalProto, m_analogProto);
 
     Cascade::setLayout(m_digitalProto);
   }
 
+  void LowShelfBase::setGain(double gainDb) {
+    if (m_order < 1) throw std::invalid_argument(gainBeforeSetup);
+
+    m_analogProto.design(m_order, gainDb);
+
+    m_digitalProto.reset();
+    m_transform.apply(Cascade::resetStages((m_order + 1) / 2), m_analogProto);
+
+    // the lowpass transform keeps the normal frequency
+    Cascade::normalise(m_analogProto.getNormalW(), m_analogProto.getNormalGain());
+  }
+
   void HighShelfBase::setup(int order, double cutoffFrequency, double gainDb) {
+    m_transform.setup(cutoffFrequency);
+    m_order = order;
+
     m_analogProto.design(order, gainDb);
 
-    HighPassTransform(cutoffFrequency, m_digitalProto, m_analogProto);
+    m_transform.apply(m_digitalProto, m_analogProto);
 
     Cascade::setLayout(m_digitalProto);
   }
 
+  void HighShelfBase::setGain(double gainDb) {
+    if (m_order < 1) throw std::invalid_argument(gainBeforeSetup);
+
+    m_analogProto.design(m_order, gainDb);
+
+    m_digitalProto.reset();
+    m_transform.apply(Cascade::resetStages((m_order + 1) / 2), m_analogProto);
+
+    // the highpass transform mirrors the normal frequency
+    Cascade::normalise(doublePi - m_analogProto.getNormalW(), m_analogProto.getNormalGain());
+  }
+
   void BandShelfBase::setup(
       int order, double centerFrequency, double widthFrequency, double gainDb) {
+    m_transform.setup(centerFrequency, widthFrequency);
+    m_order   = order;
+    m_normalW = (centerFrequency < 0.25) ? doublePi : 0;
+
     m_analogProto.design(order, gainDb);
 
-    BandPassTransform(centerFrequency, widthFrequency, m_digitalProto, m_analogProto);
+    m_transform.apply(m_digitalProto, m_analogProto);
 
     // HACK!
-    m_digitalProto.setNormal((centerFrequency < 0.25) ? doublePi : 0, 1);
+    m_digitalProto.setNormal(m_normalW, 1);
 
     Cascade::setLayout(m_digitalProto);
   }
 
+  void BandShelfBase::setGain(double gainDb) {
+    if (m_order < 1) throw std::invalid_argument(gainBeforeSetup);
+
+    m_analogProto.design(m_order, gainDb);
+
+    m_digitalProto.reset();
+    m_transform.apply(Cascade::resetStages(m_order), m_analogProto);
+
+    Cascade::normalise(m_normalW, 1);
+  }
+
 }}  // namespace Iir::Butterworth
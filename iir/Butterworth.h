@@ -76,8 +76,10 @@ namespace Iir {
       void design(int numPoles, double gainDb);
 
     private:
-      int    m_numPoles;
-      double m_gainDb;
+      int       m_numPoles;
+      double    m_gainDb;
+      complex_t m_firstAngle;
+      complex_t m_rotation;
     };
 
     //------------------------------------------------------------------------------
@@ -100,14 +102,48 @@ namespace Iir {
 
     struct DllExport LowShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(int order, double cutoffFrequency, double gainDb);
+
+      /**
+       * Changes only the gain. The radii of the analog poles and zeros
+       * depend on the gain, so the prototype is designed again, but with
+       * the angles of the last setup(). It is then transformed with the
+       * frequency constants of setup() straight into the biquads with
+       * real numbers, without the digital pole/zero layout. getPoleZeros()
+       * then recovers the poles and zeros from the biquads.
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb);
+
+    private:
+      LowPassTransform m_transform;
+      int              m_order = 0;
     };
 
     struct DllExport HighShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(int order, double cutoffFrequency, double gainDb);
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      HighPassTransform m_transform;
+      int               m_order = 0;
     };
 
     struct DllExport BandShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(int order, double centerFrequency, double widthFrequency, double gainDb);
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      BandPassTransform m_transform;
+      int               m_order = 0;
+      double            m_normalW = 0;
     };
 
     //------------------------------------------------------------------------------
@@ -130,6 +166,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency) {
         LowPassBase::setup(FilterOrder, cutoffFrequency / sampleRate);
+        this->stagesChanged();
       }
 
       /**
@@ -141,6 +178,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowPassBase::setup(reqOrder, cutoffFrequency / sampleRate);
+        this->stagesChanged();
       }
 
       /**
@@ -149,6 +187,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency) {
         LowPassBase::setup(FilterOrder, cutoffFrequency);
+        this->stagesChanged();
       }
 
       /**
@@ -159,6 +198,7 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowPassBase::setup(reqOrder, cutoffFrequency);
+        this->stagesChanged();
       }
     };
 
@@ -176,6 +216,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency) {
         HighPassBase::setup(FilterOrder, cutoffFrequency / sampleRate);
+        this->stagesChanged();
       }
       /**
        * Calculates the coefficients
@@ -186,6 +227,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighPassBase::setup(reqOrder, cutoffFrequency / sampleRate);
+        this->stagesChanged();
       }
 
       /**
@@ -194,6 +236,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency) {
         HighPassBase::setup(FilterOrder, cutoffFrequency);
+        this->stagesChanged();
       }
       /**
        * Calculates the coefficients
@@ -203,6 +246,7 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighPassBase::setup(reqOrder, cutoffFrequency);
+        this->stagesChanged();
       }
     };
 
@@ -221,6 +265,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double centerFrequency, double widthFrequency) {
         BandPassBase::setup(FilterOrder, centerFrequency / sampleRate, widthFrequency / sampleRate);
+        this->stagesChanged();
       }
 
       /**
@@ -233,6 +278,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double centerFrequency, double widthFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandPassBase::setup(reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate);
+        this->stagesChanged();
       }
 
       /**
@@ -242,6 +288,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency) {
         BandPassBase::setup(FilterOrder, centerFrequency, widthFrequency);
+        this->stagesChanged();
       }
 
       /**
@@ -253,6 +300,7 @@ namespace Iir {
       void setupN(int reqOrder, double centerFrequency, double widthFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandPassBase::setup(reqOrder, centerFrequency, widthFrequency);
+        this->stagesChanged();
       }
     };
 
@@ -271,6 +319,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double centerFrequency, double widthFrequency) {
         BandStopBase::setup(FilterOrder, centerFrequency / sampleRate, widthFrequency / sampleRate);
+        this->stagesChanged();
       }
 
       /**
@@ -283,6 +332,7 @@ namespace Iir {
       void setupN(int reqOrder, double sampleRate, double centerFrequency, double widthFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandStopBase::setup(reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate);
+        this->stagesChanged();
       }
 
       /**
@@ -292,6 +342,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency) {
         BandStopBase::setup(FilterOrder, centerFrequency, widthFrequency);
+        this->stagesChanged();
       }
 
       /**
@@ -303,6 +354,7 @@ namespace Iir {
       void setupN(int reqOrder, double centerFrequency, double widthFrequency) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandStopBase::setup(reqOrder, centerFrequency, widthFrequency);
+        this->stagesChanged();
       }
     };
 
@@ -322,6 +374,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double gainDb) {
         LowShelfBase::setup(FilterOrder, cutoffFrequency / sampleRate, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -334,6 +387,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency, double gainDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowShelfBase::setup(reqOrder, cutoffFrequency / sampleRate, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -343,6 +397,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double gainDb) {
         LowShelfBase::setup(FilterOrder, cutoffFrequency, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -354,6 +409,16 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double gainDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowShelfBase::setup(reqOrder, cutoffFrequency, gainDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        LowShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -373,6 +438,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double gainDb) {
         HighShelfBase::setup(FilterOrder, cutoffFrequency / sampleRate, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -385,6 +451,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency, double gainDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighShelfBase::setup(reqOrder, cutoffFrequency / sampleRate, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -394,6 +461,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double gainDb) {
         HighShelfBase::setup(FilterOrder, cutoffFrequency, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -405,6 +473,16 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double gainDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighShelfBase::setup(reqOrder, cutoffFrequency, gainDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see HighShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        HighShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -427,6 +505,7 @@ namespace Iir {
       void setup(double sampleRate, double centerFrequency, double widthFrequency, double gainDb) {
         BandShelfBase::setup(
             FilterOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -446,6 +525,7 @@ namespace Iir {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandShelfBase::setup(
             reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -456,6 +536,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency, double gainDb) {
         BandShelfBase::setup(FilterOrder, centerFrequency, widthFrequency, gainDb);
+        this->stagesChanged();
       }
 
       /**
@@ -468,6 +549,16 @@ namespace Iir {
       void setupN(int reqOrder, double centerFrequency, double widthFrequency, double gainDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandShelfBase::setup(reqOrder, centerFrequency, widthFrequency, gainDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see BandShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        BandShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -37,6 +37,8 @@
 
 #include "Common.h"
 
+#include <algorithm>
+
 namespace Iir {
 
   Cascade::Cascade() : m_numStages(0), m_maxStages(0), m_stageArray(0) {}
@@ -47,6 +49,11 @@ namespace Iir {
     m_stageArray = storage.stageArray;
   }
 
+  void Cascade::rebindCascadeStorage(const Storage& storage) {
+    m_maxStages  = storage.maxStages;
+    m_stageArray = storage.stageArray;
+  }
+
   complex_t Cascade::response(double normalizedFrequency) const {
     double          w    = 2 * doublePi * normalizedFrequency;
     const complex_t czn1 = std::polar(1., -w);
@@ -87,21 +94,153 @@ namespace Iir {
     m_stageArray->applyScale(scale);
   }
 
-  void Cascade::setLayout(const LayoutBase& proto) {
-    const int numPoles = proto.getNumPoles();
-    m_numStages        = (numPoles + 1) / 2;
-    if (m_numStages > m_maxStages)
+  Biquad* Cascade::resetStages(int numStages) {
+    if (numStages > m_maxStages)
       throw std::invalid_argument("Number of stages is larger than the max stages.");
+    m_numStages = numStages;
 
-    Biquad* stage = m_stageArray;
-    for (int i = 0; i < m_maxStages; ++i, ++stage)
+    Biquad* stage = m_stageArray + numStages;
+    for (int i = numStages; i < m_maxStages; ++i, ++stage)
       stage->setIdentity();
 
-    stage = m_stageArray;
+    return m_stageArray;
+  }
+
+  void Cascade::setLayout(const LayoutBase& proto) {
+    const int numPoles = proto.getNumPoles();
+    Biquad*   stage    = resetStages((numPoles + 1) / 2);
     for (int i = 0; i < m_numStages; ++i, ++stage)
       stage->setPoleZeroPair(proto[i]);
 
-    applyScale(proto.getNormalGain() / std::abs(response(proto.getNormalW() / (2 * doublePi))));
+    normalise(proto.getNormalW(), proto.getNormalGain());
+  }
+
+  void Cascade::normalise(double normalW, double normalGain) {
+    // at DC and Nyquist the response is real which is cheaper to evaluate
+    double gain;
+    if ((normalW == 0) || (normalW == doublePi)) {
+      const double  z     = (normalW == 0) ? 1 : -1;
+      const Biquad* stage = m_stageArray;
+      gain                = 1;
+      for (int i = 0; i < m_numStages; ++i, ++stage)
+        gain *= (stage->m_b0 + z * stage->m_b1 + stage->m_b2) / (1 + z * stage->m_a1 + stage->m_a2);
+      gain = fabs(gain);
+    } else {
+      gain = std::abs(response(normalW / (2 * doublePi)));
+    }
+    applyScale(normalGain / gain);
+  }
+
+  //------------------------------------------------------------------------------
+
+  // number of frequencies between DC and Nyquist to evaluate the norms
+  static const int normGridSize = 1024;
+
+  // root of c0*z^2 + c1*z + c2 with the largest magnitude. A zero at
+  // infinity (c0 = 0) is returned as NAN.
+  static complex_t largestRoot(double c0, double c1, double c2) {
+    if (c0 == 0) return complex_t(std::numeric_limits<double>::quiet_NaN());
+    const complex_t d  = std::sqrt(complex_t(c1 * c1 - 4 * c0 * c2));
+    const complex_t r1 = (-c1 + d) / (2 * c0);
+    const complex_t r2 = (-c1 - d) / (2 * c0);
+    const complex_t r  = (std::abs(r1) >= std::abs(r2)) ? r1 : r2;
+    return complex_t(r.real(), fabs(r.imag()));
+  }
+
+  static bool isIdentity(const Biquad& s) {
+    return (s.m_a1 == 0) && (s.m_a2 == 0) && (s.m_b1 == 0) && (s.m_b2 == 0);
+  }
+
+  static complex_t stageResponse(const Biquad& s, const complex_t czn1, const complex_t czn2) {
+    return (s.m_b0 + s.m_b1 * czn1 + s.m_b2 * czn2) / (1. + s.m_a1 * czn1 + s.m_a2 * czn2);
+  }
+
+  void Cascade::optimiseStages(Biquad* stages, int numStages, ScalingNorm norm) {
+    // gain of the identity stages and the stages with poles/zeros
+    double              identityGain = 1;
+    std::vector<Biquad> active;
+    for (int i = 0; i < numStages; i++) {
+      if (isIdentity(stages[i]))
+        identityGain *= stages[i].m_b0;
+      else
+        active.push_back(stages[i]);
+    }
+    const int n = (int) active.size();
+    if (n == 0) return;
+
+    // pair the poles closest to the unit circle first with their closest zeros
+    std::vector<int>    byRadius(n);
+    std::vector<double> radius(n);
+    for (int i = 0; i < n; i++) {
+      byRadius[i] = i;
+      radius[i]   = std::abs(largestRoot(1, active[i].m_a1, active[i].m_a2));
+    }
+    std::stable_sort(byRadius.begin(), byRadius.end(), [&radius](int a, int b) {
+      return radius[a] > radius[b];
+    });
+
+    std::vector<bool>   used(n, false);
+    std::vector<Biquad> paired(n);
+    for (int k = 0; k < n; k++) {
+      const Biquad&   den        = active[byRadius[k]];
+      const complex_t pole       = largestRoot(1, den.m_a1, den.m_a2);
+      const bool      singlePole = den.m_a2 == 0;
+      int             best       = -1;
+      double          bestDist   = 0;
+      for (int pass = 0; (pass < 2) && (best < 0); pass++) {
+        for (int j = 0; j < n; j++) {
+          if (used[j]) continue;
+          // a single pole needs a numerator of the first order if there is one
+          if ((pass == 0) && (singlePole != (active[j].m_b2 == 0))) continue;
+          const complex_t zero = largestRoot(active[j].m_b0, active[j].m_b1, active[j].m_b2);
+          double          dist = std::abs(zero - pole);
+          if (dist != dist) dist = std::numeric_limits<double>::max();
+          if ((best < 0) || (dist < bestDist)) {
+            best     = j;
+            bestDist = dist;
+          }
+        }
+      }
+      used[best]    = true;
+      Biquad& stage = paired[n - 1 - k];  // increasing pole radius
+      stage         = den;
+      stage.m_b0    = active[best].m_b0;
+      stage.m_b1    = active[best].m_b1;
+      stage.m_b2    = active[best].m_b2;
+    }
+
+    // scale the cumulative response of every stage to the unity norm
+    std::vector<complex_t> czn1(normGridSize);
+    std::vector<complex_t> czn2(normGridSize);
+    std::vector<complex_t> h(normGridSize, complex_t(1));
+    for (int g = 0; g < normGridSize; g++) {
+      const double w = doublePi * (g + 0.5) / normGridSize;
+      czn1[g]        = std::polar(1., -w);
+      czn2[g]        = std::polar(1., -2 * w);
+    }
+    double total = 1;
+    for (int k = 0; k < n - 1; k++) {
+      double sum = 0;
+      double max = 0;
+      for (int g = 0; g < normGridSize; g++) {
+        h[g] *= stageResponse(paired[k], czn1[g], czn2[g]);
+        const double a = std::abs(h[g]);
+        sum += a * a;
+        if (a > max) max = a;
+      }
+      const double value = (norm == normL2) ? sqrt(sum / normGridSize) : max;
+      if (!(value > 0) || std::isinf(value)) continue;
+      paired[k].applyScale(1 / value);
+      for (int g = 0; g < normGridSize; g++)
+        h[g] /= value;
+      total /= value;
+    }
+    paired[n - 1].applyScale(identityGain / total);
+
+    for (int i = 0; i < n; i++)
+      stages[i] = paired[i];
+    for (int i = n; i < numStages; i++)
+      stages[i].setIdentity();
   }
 
 }  // namespace Iir
@@ -37,6 +37,7 @@
 #define IIR1_CASCADE_H
 
 #include "Biquad.h"
+#include "Block.h"
 #include "Common.h"
 #include "Layout.h"
 #include "MathSupplement.h"
@@ -93,15 +94,50 @@ namespace Iir {
      **/
     std::vector<PoleZeroPair> getPoleZeros() const;
 
+    /**
+     * Reorders and scales a cascade of biquads without changing its overall
+     * transfer function. Every pair of poles gets the zeros which are closest
+     * to it, starting with the poles closest to the unit circle, and the stages
+     * are then ordered by increasing pole radius. The gain is distributed so that
+     * the norm from the input to the output of every stage is one, apart from
+     * the last stage which takes the remaining gain. Identity stages are moved
+     * to the end.
+     * \param stages Array of biquads
+     * \param numStages Number of biquads
+     * \param norm Scaling with the L2 or the L-infinity norm
+     **/
+    static void optimiseStages(Biquad* stages, int numStages, ScalingNorm norm = normLinf);
+
   protected:
     Cascade();
 
     void setCascadeStorage(const Storage& storage);
 
+    /**
+     * Points to another array with a copy of the biquads (for example
+     * after copying a filter) and keeps the number of stages.
+     **/
+    void rebindCascadeStorage(const Storage& storage);
+
     void applyScale(double scale);
 
     void setLayout(const LayoutBase& proto);
 
+    /**
+     * Sets the number of stages for an update of the biquads without a
+     * pole/zero layout. The stages above it become identities.
+     * \param numStages Number of stages
+     * \return The array of the biquads
+     **/
+    Biquad* resetStages(int numStages);
+
+    /**
+     * Scales the cascade so that it has the given gain at one frequency
+     * \param normalW Angular frequency from 0 to pi (Nyquist)
+     * \param normalGain The gain at normalW
+     **/
+    void normalise(double normalW, double normalGain);
+
   private:
     int     m_numStages;
     int     m_maxStages;
@@ -141,6 +177,22 @@ namespace Iir {
             sosCoefficients[i][1],
             sosCoefficients[i][2]);
       }
+      updateStates();
+    }
+
+    /**
+     * Passes the coefficients of the biquads to the states which run them
+     * in another form (for example StateVariableForm) so that they only
+     * map them once and not at every sample. The designs do this for you
+     * but it needs to be called after changing the biquads directly through
+     * getCascadeStorage(). Debug builds assert this while filtering.
+     * \param digital The poles and zeros of the biquads if they are known,
+     * otherwise the states derive them from the coefficients
+     **/
+    void updateStates(const LayoutBase* digital = nullptr) {
+      const int numPairs = (digital != nullptr) ? (digital->getNumPoles() + 1) / 2 : 0;
+      for (int i = 0; i < (int) MaxStages; i++)
+        updateState(m_states[i], m_stages[i], (i < numPairs) ? &(*digital)[i] : nullptr, 0);
     }
 
   public:
@@ -151,6 +203,7 @@ namespace Iir {
      **/
     template<typename Sample>
     inline Sample filter(const Sample in) {
+      assert(statesAreCurrent());
       double     out   = in;
       StateType* state = m_states;
       for (const auto& stage : m_stages)
@@ -158,6 +211,144 @@ namespace Iir {
       return static_cast<Sample>(out);
     }
 
+    /**
+     * Filters a block of samples. The buffers can be strided, for example
+     * one channel of an interleaved buffer, and can be the same (in-place).
+     * \param in Input samples
+     * \param n Number of samples
+     * \param out Output samples
+     * \param inStride Distance between two input samples
+     * \param outStride Distance between two output samples
+     **/
+    template<typename Sample>
+    void filter(const Sample* in, int n, Sample* out, int inStride = 1, int outStride = 1) {
+      for (int i = 0; i < n; i++) {
+        *out = filter(*in);
+        in += inStride;
+        out += outStride;
+      }
+    }
+
+    /**
+     * Filters a block of samples and calculates the statistics of the
+     * output (peak, sum of squares, min, max) in the same pass.
+     * \param in Input samples
+     * \param n Number of samples
+     * \param out Output samples
+     * \param stats Statistics of this block (reset at the start)
+     * \param inStride Distance between two input samples
+     * \param outStride Distance between two output samples
+     **/
+    template<typename Sample>
+    void filter(const Sample* in, int n, Sample* out, BlockStatistics& stats, int inStride = 1,
+                int outStride = 1) {
+      stats.reset();
+      for (int i = 0; i < n; i++) {
+        const Sample y = filter(*in);
+        *out           = y;
+        stats.add(static_cast<double>(y));
+        in += inStride;
+        out += outStride;
+      }
+    }
+
+    /**
+     * Filters a block of samples with an input gain / offset and
+     * a dry/wet mix of the output which are applied in the same loop.
+     * \param in Input samples
+     * \param n Number of samples
+     * \param out Output samples
+     * \param mix Input transform and output mix
+     * \param inStride Distance between two input samples
+     * \param outStride Distance between two output samples
+     **/
+    template<typename Sample>
+    void filter(const Sample* in, int n, Sample* out, const BlockMix& mix, int inStride = 1,
+                int outStride = 1) {
+      for (int i = 0; i < n; i++) {
+        const double u = mix.transform(static_cast<double>(*in));
+        *out           = static_cast<Sample>(mix.mix(u, filter(u)));
+        in += inStride;
+        out += outStride;
+      }
+    }
+
+    /**
+     * Filters one complex (I/Q) sample through the whole chain of biquads.
+     * Needs one of the complex states such as ComplexDirectFormII.
+     * \param in Complex sample to be filtered
+     * \return filtered complex sample
+     **/
+    template<typename Real>
+    inline std::complex<Real> filter(const std::complex<Real> in) {
+      assert(statesAreCurrent());
+      complex_t  out(in.real(), in.imag());
+      StateType* state = m_states;
+      for (const auto& stage : m_stages)
+        out = (state++)->filter(out, stage);
+      return std::complex<Real>(static_cast<Real>(out.real()), static_cast<Real>(out.imag()));
+    }
+
+    /**
+     * Filters a block of samples and decimates the result by M so that
+     * out[k] = y[k*M]. Only the last biquad can skip its output for the
+     * discarded samples as the earlier ones feed into the next one.
+     * \param in Input samples
+     * \param n Number of input samples, needs to be a multiple of M
+     * \param M Decimation factor
+     * \param out Output samples, needs space for n/M samples
+     * \return Number of output samples
+     **/
+    template<typename Sample>
+    int filterDecimate(const Sample* in, int n, int M, Sample* out) {
+      if (M < 1) throw std::invalid_argument("The decimation factor needs to be positive.");
+      if ((n < 0) || ((n % M) != 0))
+        throw std::invalid_argument("The number of samples needs to be a multiple of the decimation factor.");
+
+      const int last = static_cast<int>(MaxStages) - 1;
+      for (int i = 0; i < n; i += M) {
+        *out++ = filter(in[i]);
+        for (int j = i + 1; j < i + M; j++) {
+          double x = in[j];
+          for (int k = 0; k < last; k++)
+            x = m_states[k].filter(x, m_stages[k]);
+          advanceState(m_states[last], x, m_stages[last], 0);
+        }
+      }
+      return n / M;
+    }
+
+    /**
+     * Reorders the biquads and distributes the gain between them for a
+     * better dynamic range in reduced precision (see Cascade::optimiseStages).
+     * Resets the delay lines.
+     * \param norm Scaling with the L2 or the L-infinity norm
+     **/
+    void optimise(ScalingNorm norm = normLinf) {
+      Cascade::optimiseStages(m_stages, MaxStages, norm);
+      updateStates();
+      reset();
+    }
+
+    /**
+     * Returns the state (delay lines) of one biquad
+     * \param stage Index of the biquad
+     **/
+    const StateType& getState(int stage) const {
+      if ((stage < 0) || (stage >= (int) MaxStages)) throw std::invalid_argument("Index out of bounds.");
+      return m_states[stage];
+    }
+
+    /**
+     * Returns the state (delay lines) of one biquad for changing it,
+     * for example the coefficients of a LatticeLadder
+     * \param stage Index of the biquad
+     **/
+    StateType& getState(int stage) {
+      if ((stage < 0) || (stage >= (int) MaxStages)) throw std::invalid_argument("Index out of bounds.");
+      return m_states[stage];
+    }
+
     /**
      * Returns the coefficients of the entire Biquad chain
      **/
@@ -166,6 +357,47 @@ namespace Iir {
     }
 
   private:
+    // only states which keep coefficients of their own have setCoefficients()
+    template<class State>
+    static auto updateState(State& state, const Biquad& stage, const PoleZeroPair* pair, int)
+        -> decltype(state.setCoefficients(stage, pair), void()) {
+      state.setCoefficients(stage, pair);
+    }
+
+    template<class State>
+    static void updateState(State&, const Biquad&, const PoleZeroPair*, long) {}
+
+    // only states which keep coefficients of their own remember their biquad
+    template<class State>
+    static auto isCurrent(const State& state, const Biquad& stage, int)
+        -> decltype(state.isMappedFrom(stage)) {
+      return state.isMappedFrom(stage);
+    }
+
+    template<class State>
+    static bool isCurrent(const State&, const Biquad&, long) {
+      return true;
+    }
+
+    // checked in debug builds: the biquads have not been changed without updateStates()
+    bool statesAreCurrent() const {
+      for (int i = 0; i < (int) MaxStages; i++)
+        if (!isCurrent(m_states[i], m_stages[i], 0)) return false;
+      return true;
+    }
+
+    // states without advance() calculate the output and discard it
+    template<class State>
+    static auto advanceState(State& state, const double in, const Biquad& stage, int)
+        -> decltype(state.advance(in, stage), void()) {
+      state.advance(in, stage);
+    }
+
+    template<class State>
+    static void advanceState(State& state, const double in, const Biquad& stage, long) {
+      state.filter(in, stage);
+    }
+
     Biquad    m_stages[MaxStages];
     StateType m_states[MaxStages];
   };
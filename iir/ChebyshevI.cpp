@@ -81,12 +81,21 @@ namespace Iir { namespace ChebyshevI {
   // http://www.ece.rutgers.edu/~orfanidi/ece521/hpeq.pdf
   //
 
-  AnalogLowShelf::AnalogLowShelf() {
+  AnalogLowShelf::AnalogLowShelf() : m_numPoles(-1) {
     setNormal(doublePi, 1);
   }
 
   void AnalogLowShelf::design(int numPoles, double gainDb, double rippleDb) {
     if (m_numPoles != numPoles || m_rippleDb != rippleDb || m_gainDb != gainDb) {
+      const double n2 = 2 * numPoles;
+
+      // the angles doublePi * (2 * i - 1) / n2 by rotation, only calculated
+      // again when the order changes
+      if (m_numPoles != numPoles) {
+        m_rotation   = std::polar(1., 2 * doublePi / n2);
+        m_firstAngle = std::polar(1., doublePi / n2);
+      }
+
       m_numPoles = numPoles;
       m_rippleDb = rippleDb;
       m_gainDb   = gainDb;
@@ -98,33 +107,31 @@ namespace Iir { namespace ChebyshevI {
       if (rippleDb >= fabs(gainDb)) rippleDb = fabs(gainDb);
       if (gainDb < 0) rippleDb = -rippleDb;
 
-      const double G  = std::pow(10., gainDb / 20.0);
-      const double Gb = std::pow(10., (gainDb - rippleDb) / 20.0);
-      const double G0 = 1;
-      const double g0 = pow(G0, 1. / numPoles);
+      const double G  = exp(gainDb * doubleLn10 / 20);
+      const double Gb = exp((gainDb - rippleDb) * doubleLn10 / 20);
 
       double eps;
-      if (Gb != G0)
-        eps = sqrt((G * G - Gb * Gb) / (Gb * Gb - G0 * G0));
+      if (Gb != 1)
+        eps = sqrt((G * G - Gb * Gb) / (Gb * Gb - 1));
       else
         eps = G - 1;  // This is surely wrong
 
-      const double b = pow(G / eps + Gb * sqrt(1 + 1 / (eps * eps)), 1. / numPoles);
-      const double u = log(b / g0);
-      const double v = log(pow(1. / eps + sqrt(1 + 1 / (eps * eps)), 1. / numPoles));
+      // exp(u) and exp(v) give sinh and cosh without log()
+      const double eu = pow(G / eps + Gb * sqrt(1 + 1 / (eps * eps)), 1. / numPoles);
+      const double ev = pow(1. / eps + sqrt(1 + 1 / (eps * eps)), 1. / numPoles);
 
-      const double sinh_u = sinh(u);
-      const double sinh_v = sinh(v);
-      const double cosh_u = cosh(u);
-      const double cosh_v = cosh(v);
-      const double n2     = 2 * numPoles;
+      const double sinh_u = (eu - 1 / eu) / 2;
+      const double sinh_v = (ev - 1 / ev) / 2;
+      const double cosh_u = (eu + 1 / eu) / 2;
+      const double cosh_v = (ev + 1 / ev) / 2;
       const int    pairs  = numPoles / 2;
+      complex_t    d      = m_firstAngle;
       for (int i = 1; i <= pairs; ++i) {
-        const double a  = doublePi * (2 * i - 1) / n2;
-        const double sn = sin(a);
-        const double cs = cos(a);
+        const double sn = d.imag();
+        const double cs = d.real();
         addPoleZeroConjugatePairs(
             complex_t(-sn * sinh_u, cs * cosh_u), complex_t(-sn * sinh_v, cs * cosh_v));
+        d *= m_rotation;
       }
 
       if (numPoles & 1) add(-sinh_u, -sinh_v);
@@ -168,30 +175,78 @@ namespace Iir { namespace ChebyshevI {
   }
 
   void LowShelfBase::setup(int order, double cutoffFrequency, double gainDb, double rippleDb) {
+    m_transform.setup(cutoffFrequency);
+    m_order    = order;
+    m_rippleDb = rippleDb;
+
     m_analogProto.design(order, gainDb, rippleDb);
 
-    LowPassTransform(cutoffFrequency, m_digitalProto, m_analogProto);
+    m_transform.apply(m_digitalProto, m_analogProto);
 
     Cascade::setLayout(m_digitalProto);
   }
 
+  void LowShelfBase::setGain(double gainDb) {
+    if (m_order < 1) throw std::invalid_argument(gainBeforeSetup);
+
+    m_analogProto.design(m_order, gainDb, m_rippleDb);
+
+    m_digitalProto.reset();
+    m_transform.apply(Cascade::resetStages((m_order + 1) / 2), m_analogProto);
+
+    // the lowpass transform keeps the normal frequency
+    Cascade::normalise(m_analogProto.getNormalW(), m_analogProto.getNormalGain());
+  }
+
   void HighShelfBase::setup(int order, double cutoffFrequency, double gainDb, double rippleDb) {
+    m_transform.setup(cutoffFrequency);
+    m_order    = order;
+    m_rippleDb = rippleDb;
+
     m_analogProto.design(order, gainDb, rippleDb);
 
-    HighPassTransform(cutoffFrequency, m_digitalProto, m_analogProto);
+    m_transform.apply(m_digitalProto, m_analogProto);
 
     Cascade::setLayout(m_digitalProto);
   }
 
+  void HighShelfBase::setGain(double gainDb) {
+    if (m_order < 1) throw std::invalid_argument(gainBeforeSetup);
+
+    m_analogProto.design(m_order, gainDb, m_rippleDb);
+
+    m_digitalProto.reset();
+    m_transform.apply(Cascade::resetStages((m_order + 1) / 2), m_analogProto);
+
+    // the highpass transform mirrors the normal frequency
+    Cascade::normalise(doublePi - m_analogProto.getNormalW(), m_analogProto.getNormalGain());
+  }
+
   void BandShelfBase::setup(
       int order, double centerFrequency, double widthFrequency, double gainDb, double rippleDb) {
+    m_transform.setup(centerFrequency, widthFrequency);
+    m_order    = order;
+    m_rippleDb = rippleDb;
+    m_normalW  = (centerFrequency < 0.25) ? doublePi : 0;
+
     m_analogProto.design(order, gainDb, rippleDb);
 
-    BandPassTransform(centerFrequency, widthFrequency, m_digitalProto, m_analogProto);
+    m_transform.apply(m_digitalProto, m_analogProto);
 
-    m_digitalProto.setNormal((centerFrequency < 0.25) ? doublePi : 0, 1);
+    m_digitalProto.setNormal(m_normalW, 1);
 
     Cascade::setLayout(m_digitalProto);
   }
 
+  void BandShelfBase::setGain(double gainDb) {
+    if (m_order < 1) throw std::invalid_argument(gainBeforeSetup);
+
+    m_analogProto.design(m_order, gainDb, m_rippleDb);
+
+    m_digitalProto.reset();
+    m_transform.apply(Cascade::resetStages(m_order), m_analogProto);
+
+    Cascade::normalise(m_normalW, 1);
+  }
+
 }}  // namespace Iir::ChebyshevI
@@ -73,9 +73,11 @@ namespace Iir {
       void design(int numPoles, double gainDb, double rippleDb);
 
     private:
-      int    m_numPoles;
-      double m_rippleDb;
-      double m_gainDb;
+      int       m_numPoles;
+      double    m_rippleDb;
+      double    m_gainDb;
+      complex_t m_firstAngle;
+      complex_t m_rotation;
     };
 
     //------------------------------------------------------------------------------
@@ -98,15 +100,47 @@ namespace Iir {
 
     struct DllExport LowShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(int order, double cutoffFrequency, double gainDb, double rippleDb);
+
+      /**
+       * Changes only the gain (see Butterworth::LowShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb);
+
+    private:
+      LowPassTransform m_transform;
+      int              m_order = 0;
+      double           m_rippleDb = 0;
     };
 
     struct DllExport HighShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(int order, double cutoffFrequency, double gainDb, double rippleDb);
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      HighPassTransform m_transform;
+      int               m_order = 0;
+      double            m_rippleDb = 0;
     };
 
     struct DllExport BandShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(
           int order, double centerFrequency, double widthFrequency, double gainDb, double rippleDb);
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      BandPassTransform m_transform;
+      int               m_order = 0;
+      double            m_rippleDb = 0;
+      double            m_normalW = 0;
     };
 
     //------------------------------------------------------------------------------
@@ -130,6 +164,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double rippleDb) {
         LowPassBase::setup(FilterOrder, cutoffFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -142,6 +177,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowPassBase::setup(reqOrder, cutoffFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -151,6 +187,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double rippleDb) {
         LowPassBase::setup(FilterOrder, cutoffFrequency, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -162,6 +199,7 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowPassBase::setup(reqOrder, cutoffFrequency, rippleDb);
+        this->stagesChanged();
       }
     };
 
@@ -180,6 +218,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double rippleDb) {
         HighPassBase::setup(FilterOrder, cutoffFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -192,6 +231,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighPassBase::setup(reqOrder, cutoffFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -201,6 +241,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double rippleDb) {
         HighPassBase::setup(FilterOrder, cutoffFrequency, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -212,6 +253,7 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighPassBase::setup(reqOrder, cutoffFrequency, rippleDb);
+        this->stagesChanged();
       }
     };
 
@@ -233,6 +275,7 @@ namespace Iir {
           setup(double sampleRate, double centerFrequency, double widthFrequency, double rippleDb) {
         BandPassBase::setup(
             FilterOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -252,6 +295,7 @@ namespace Iir {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandPassBase::setup(
             reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -262,6 +306,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency, double rippleDb) {
         BandPassBase::setup(FilterOrder, centerFrequency, widthFrequency, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -274,6 +319,7 @@ namespace Iir {
       void setupN(int reqOrder, double centerFrequency, double widthFrequency, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandPassBase::setup(reqOrder, centerFrequency, widthFrequency, rippleDb);
+        this->stagesChanged();
       }
     };
 
@@ -295,6 +341,7 @@ namespace Iir {
           setup(double sampleRate, double centerFrequency, double widthFrequency, double rippleDb) {
         BandStopBase::setup(
             FilterOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -314,6 +361,7 @@ namespace Iir {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandStopBase::setup(
             reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -324,6 +372,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency, double rippleDb) {
         BandStopBase::setup(FilterOrder, centerFrequency, widthFrequency, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -336,6 +385,7 @@ namespace Iir {
       void setupN(int reqOrder, double centerFrequency, double widthFrequency, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandStopBase::setup(reqOrder, centerFrequency, widthFrequency, rippleDb);
+        this->stagesChanged();
       }
     };
 
@@ -355,6 +405,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double gainDb, double rippleDb) {
         LowShelfBase::setup(FilterOrder, cutoffFrequency / sampleRate, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -369,6 +420,7 @@ namespace Iir {
           int reqOrder, double sampleRate, double cutoffFrequency, double gainDb, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowShelfBase::setup(reqOrder, cutoffFrequency / sampleRate, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -379,6 +431,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double gainDb, double rippleDb) {
         LowShelfBase::setup(FilterOrder, cutoffFrequency, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -391,6 +444,16 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double gainDb, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowShelfBase::setup(reqOrder, cutoffFrequency, gainDb, rippleDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        LowShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -410,6 +473,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double gainDb, double rippleDb) {
         HighShelfBase::setup(FilterOrder, cutoffFrequency / sampleRate, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -424,6 +488,7 @@ namespace Iir {
           int reqOrder, double sampleRate, double cutoffFrequency, double gainDb, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighShelfBase::setup(reqOrder, cutoffFrequency / sampleRate, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -434,6 +499,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double gainDb, double rippleDb) {
         HighShelfBase::setup(FilterOrder, cutoffFrequency, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -446,6 +512,16 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double gainDb, double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighShelfBase::setup(reqOrder, cutoffFrequency, gainDb, rippleDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see HighShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        HighShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -477,6 +553,7 @@ namespace Iir {
             widthFrequency / sampleRate,
             gainDb,
             rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -498,6 +575,7 @@ namespace Iir {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandShelfBase::setup(
             reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -509,6 +587,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency, double gainDb, double rippleDb) {
         BandShelfBase::setup(FilterOrder, centerFrequency, widthFrequency, gainDb, rippleDb);
+        this->stagesChanged();
       }
 
       /**
@@ -527,6 +606,16 @@ namespace Iir {
           double rippleDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandShelfBase::setup(reqOrder, centerFrequency, widthFrequency, gainDb, rippleDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see BandShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        BandShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
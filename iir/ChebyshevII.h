@@ -76,9 +76,11 @@ namespace Iir {
       void design(int numPoles, double gainDb, double stopBandDb);
 
     private:
-      int    m_numPoles;
-      double m_stopBandDb;
-      double m_gainDb;
+      int       m_numPoles;
+      double    m_stopBandDb;
+      double    m_gainDb;
+      complex_t m_firstAngle;
+      complex_t m_rotation;
     };
 
     //------------------------------------------------------------------------------
@@ -101,10 +103,31 @@ namespace Iir {
 
     struct DllExport LowShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(int order, double cutoffFrequency, double gainDb, double stopBandDb);
+
+      /**
+       * Changes only the gain (see Butterworth::LowShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb);
+
+    private:
+      LowPassTransform m_transform;
+      int              m_order = 0;
+      double           m_stopBandDb = 0;
     };
 
     struct DllExport HighShelfBase : PoleFilterBase<AnalogLowShelf> {
       void setup(int order, double cutoffFrequency, double gainDb, double stopBandDb);
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      HighPassTransform m_transform;
+      int               m_order = 0;
+      double            m_stopBandDb = 0;
     };
 
     struct DllExport BandShelfBase : PoleFilterBase<AnalogLowShelf> {
@@ -114,6 +137,17 @@ namespace Iir {
           double widthFrequency,
           double gainDb,
           double stopBandDb);
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      BandPassTransform m_transform;
+      int               m_order = 0;
+      double            m_stopBandDb = 0;
+      double            m_normalW = 0;
     };
 
     //------------------------------------------------------------------------------
@@ -137,6 +171,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double stopBandDb) {
         LowPassBase::setup(FilterOrder, cutoffFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -149,6 +184,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowPassBase::setup(reqOrder, cutoffFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -158,6 +194,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double stopBandDb) {
         LowPassBase::setup(FilterOrder, cutoffFrequency, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -169,6 +206,7 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowPassBase::setup(reqOrder, cutoffFrequency, stopBandDb);
+        this->stagesChanged();
       }
     };
 
@@ -187,6 +225,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double stopBandDb) {
         HighPassBase::setup(FilterOrder, cutoffFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -199,6 +238,7 @@ namespace Iir {
       void setup(int reqOrder, double sampleRate, double cutoffFrequency, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighPassBase::setup(reqOrder, cutoffFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -208,6 +248,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double stopBandDb) {
         HighPassBase::setup(FilterOrder, cutoffFrequency, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -219,6 +260,7 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighPassBase::setup(reqOrder, cutoffFrequency, stopBandDb);
+        this->stagesChanged();
       }
     };
 
@@ -240,6 +282,7 @@ namespace Iir {
           double sampleRate, double centerFrequency, double widthFrequency, double stopBandDb) {
         BandPassBase::setup(
             FilterOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -259,6 +302,7 @@ namespace Iir {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandPassBase::setup(
             reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -269,6 +313,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency, double stopBandDb) {
         BandPassBase::setup(FilterOrder, centerFrequency, widthFrequency, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -281,6 +326,7 @@ namespace Iir {
       void setupN(int reqOrder, double centerFrequency, double widthFrequency, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandPassBase::setup(reqOrder, centerFrequency, widthFrequency, stopBandDb);
+        this->stagesChanged();
       }
     };
 
@@ -302,6 +348,7 @@ namespace Iir {
           double sampleRate, double centerFrequency, double widthFrequency, double stopBandDb) {
         BandStopBase::setup(
             FilterOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -321,6 +368,7 @@ namespace Iir {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandStopBase::setup(
             reqOrder, centerFrequency / sampleRate, widthFrequency / sampleRate, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -331,6 +379,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency, double stopBandDb) {
         BandStopBase::setup(FilterOrder, centerFrequency, widthFrequency, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -343,6 +392,7 @@ namespace Iir {
       void setupN(int reqOrder, double centerFrequency, double widthFrequency, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandStopBase::setup(reqOrder, centerFrequency, widthFrequency, stopBandDb);
+        this->stagesChanged();
       }
     };
 
@@ -362,6 +412,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double gainDb, double stopBandDb) {
         LowShelfBase::setup(FilterOrder, cutoffFrequency / sampleRate, gainDb, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -380,6 +431,7 @@ namespace Iir {
           double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowShelfBase::setup(reqOrder, cutoffFrequency / sampleRate, gainDb, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -390,6 +442,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double gainDb, double stopBandDb) {
         LowShelfBase::setup(FilterOrder, cutoffFrequency, gainDb, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -402,6 +455,16 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double gainDb, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         LowShelfBase::setup(reqOrder, cutoffFrequency, gainDb, stopBandDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see LowShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        LowShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -421,6 +484,7 @@ namespace Iir {
        **/
       void setup(double sampleRate, double cutoffFrequency, double gainDb, double stopBandDb) {
         HighShelfBase::setup(FilterOrder, cutoffFrequency / sampleRate, gainDb, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -439,6 +503,7 @@ namespace Iir {
           double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighShelfBase::setup(reqOrder, cutoffFrequency / sampleRate, gainDb, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -449,6 +514,7 @@ namespace Iir {
        **/
       void setupN(double cutoffFrequency, double gainDb, double stopBandDb) {
         HighShelfBase::setup(FilterOrder, cutoffFrequency, gainDb, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -461,6 +527,16 @@ namespace Iir {
       void setupN(int reqOrder, double cutoffFrequency, double gainDb, double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         HighShelfBase::setup(reqOrder, cutoffFrequency, gainDb, stopBandDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see HighShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        HighShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -492,6 +568,7 @@ namespace Iir {
             widthFrequency / sampleRate,
             gainDb,
             stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -517,6 +594,7 @@ namespace Iir {
             widthFrequency / sampleRate,
             gainDb,
             stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -528,6 +606,7 @@ namespace Iir {
        **/
       void setupN(double centerFrequency, double widthFrequency, double gainDb, double stopBandDb) {
         BandShelfBase::setup(FilterOrder, centerFrequency, widthFrequency, gainDb, stopBandDb);
+        this->stagesChanged();
       }
 
       /**
@@ -546,6 +625,16 @@ namespace Iir {
           double stopBandDb) {
         if (reqOrder > FilterOrder) throw std::invalid_argument(orderTooHigh);
         BandShelfBase::setup(reqOrder, centerFrequency, widthFrequency, gainDb, stopBandDb);
+        this->stagesChanged();
+      }
+
+      /**
+       * Changes only the gain (see BandShelfBase::setGain())
+       * \param gainDb Gain in dB of the shelf
+       **/
+      void setGain(double gainDb) {
+        BandShelfBase::setGain(gainDb);
+        this->stagesChanged();
       }
     };
 
@@ -65,6 +65,8 @@
 static const char orderTooHigh[] =
     "Requested order is too high. Provide a higher order for the template.";
 
+static const char gainBeforeSetup[] = "The gain can only be changed after setup().";
+
 #define DEFAULT_FILTER_ORDER 4
 
 #endif
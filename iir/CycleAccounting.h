@@ -0,0 +1,308 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_CYCLEACCOUNTING_H
+#define IIR1_CYCLEACCOUNTING_H
+
+#include "Common.h"
+
+#include <stdint.h>
+#include <atomic>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#  define IIR1_HAS_RDTSC
+#elif defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#  include <x86intrin.h>
+#  define IIR1_HAS_RDTSC
+#else
+#  include <chrono>
+#endif
+
+namespace Iir {
+
+  /**
+   * Counters of a CycleCounter at one point in time
+   **/
+  struct DllExport CycleSnapshot {
+    /// number of block calls
+    uint64_t calls = 0;
+    /// number of block calls which have been timed
+    uint64_t sampledCalls = 0;
+    /// cycles (or nanoseconds without rdtsc) of the timed calls
+    uint64_t cycles = 0;
+    /// samples of the timed calls
+    uint64_t samples = 0;
+
+    /**
+     * Average cost of one sample
+     **/
+    double getCyclesPerSample() const {
+      if (samples == 0) return 0;
+      return (double) cycles / (double) samples;
+    }
+  };
+
+  /**
+   * Hands out the indices of the counters of the threads. A thread takes
+   * the lowest free index with its first accounted call and hands it back
+   * when it exits, so threads which come and go (for example a pool which
+   * is restarted) keep getting counters of their own. If all MaxThreads
+   * indices are taken a thread gets MaxThreads, the shared counters.
+   **/
+  class DllExport CycleAccountingThread {
+  public:
+    /// Number of threads with their own counters
+    static const unsigned MaxThreads = 8;
+
+    /**
+     * Index of the calling thread from 0 to MaxThreads
+     **/
+    static unsigned getIndex() {
+      static thread_local const CycleAccountingThread thread;
+      return thread.m_index;
+    }
+
+  private:
+    CycleAccountingThread() : m_index(acquire()) {}
+
+    ~CycleAccountingThread() {
+      if (m_index < MaxThreads) taken().fetch_and(~(1u << m_index), std::memory_order_release);
+    }
+
+    CycleAccountingThread(const CycleAccountingThread&) = delete;
+    CycleAccountingThread& operator=(const CycleAccountingThread&) = delete;
+
+    // one bit per index, the acquire / release pairs make the counts of
+    // an exited thread visible to the next thread with the same index
+    static std::atomic<uint32_t>& taken() {
+      static std::atomic<uint32_t> bits{0};
+      return bits;
+    }
+
+    static unsigned acquire() {
+      uint32_t bits = taken().load(std::memory_order_relaxed);
+      for (;;) {
+        unsigned i = 0;
+        while ((i < MaxThreads) && ((bits >> i) & 1u))
+          i++;
+        if (i == MaxThreads) return MaxThreads;
+        if (taken().compare_exchange_weak(
+                bits, bits | (1u << i), std::memory_order_acquire, std::memory_order_relaxed))
+          return i;
+      }
+    }
+
+    const unsigned m_index;
+  };
+
+  /**
+   * Accumulates the cost of block filter calls of one filter or filter bank.
+   * Only every Nth call of a thread is timed (with a fenced rdtsc on x86,
+   * otherwise with a steady clock in nanoseconds) so that the timing itself
+   * hardly distorts the result.
+   * The threads which hold one of the MaxThreads indices of
+   * CycleAccountingThread each count in their own cache line which only
+   * they write to, so the audio threads never contend. Any further threads
+   * share one more line with atomic adds. snapshot() sums the lines and
+   * can be called from any thread at any time.
+   * With Enabled = false the counter is empty and counts nothing so that
+   * a project can switch the accounting off with one constant of its own.
+   * \param Enabled Counts and times the calls
+   **/
+  template<bool Enabled>
+  class DllExport CycleCounter {
+  public:
+    /// Number of threads with their own counters
+    static const unsigned MaxThreads = CycleAccountingThread::MaxThreads;
+
+    /**
+     * \param every Time every Nth call of each thread
+     **/
+    explicit CycleCounter(unsigned every = 16) : m_every(every > 0 ? every : 1) {}
+
+    /**
+     * Current time stamp in cycles. The fences keep the preceding and
+     * the following instructions out of the measured interval.
+     **/
+    static inline uint64_t now() {
+#if defined(IIR1_HAS_RDTSC)
+      _mm_lfence();
+      const uint64_t t = __rdtsc();
+      _mm_lfence();
+      return t;
+#else
+      return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+#endif
+    }
+
+    /**
+     * Counts a call of the calling thread. Returns the index of the
+     * thread's counters if the call should be timed and -1 otherwise.
+     **/
+    inline int begin() {
+      const unsigned t     = CycleAccountingThread::getIndex();
+      const uint64_t calls = increment(t, m_slots[t].calls, 1);
+      return ((calls % m_every) == 0) ? (int) t : -1;
+    }
+
+    /**
+     * Adds a timed call to the counters returned by begin()
+     **/
+    inline void add(int slot, uint64_t cycles, int numSamples) {
+      const unsigned t = (unsigned) slot;
+      increment(t, m_slots[t].sampledCalls, 1);
+      increment(t, m_slots[t].cycles, cycles);
+      increment(t, m_slots[t].samples, (uint64_t) numSamples);
+    }
+
+    /**
+     * Returns the sum of the counters of all threads
+     **/
+    CycleSnapshot snapshot() const {
+      CycleSnapshot s;
+      for (const Slot& slot : m_slots) {
+        s.calls        += slot.calls.load(std::memory_order_relaxed);
+        s.sampledCalls += slot.sampledCalls.load(std::memory_order_relaxed);
+        s.cycles       += slot.cycles.load(std::memory_order_relaxed);
+        s.samples      += slot.samples.load(std::memory_order_relaxed);
+      }
+      return s;
+    }
+
+    /**
+     * Sets all counters to zero. Calls which are counted while
+     * resetting may survive the reset.
+     **/
+    void reset() {
+      for (Slot& slot : m_slots) {
+        slot.calls.store(0, std::memory_order_relaxed);
+        slot.sampledCalls.store(0, std::memory_order_relaxed);
+        slot.cycles.store(0, std::memory_order_relaxed);
+        slot.samples.store(0, std::memory_order_relaxed);
+      }
+    }
+
+  private:
+    struct alignas(64) Slot {
+      std::atomic<uint64_t> calls{0};
+      std::atomic<uint64_t> sampledCalls{0};
+      std::atomic<uint64_t> cycles{0};
+      std::atomic<uint64_t> samples{0};
+    };
+
+    // only the owning thread writes to its slot so a plain load and store
+    // will do, the shared overflow slot needs a read-modify-write
+    static inline uint64_t increment(unsigned t, std::atomic<uint64_t>& counter, uint64_t v) {
+      if (t < MaxThreads) {
+        const uint64_t old = counter.load(std::memory_order_relaxed);
+        counter.store(old + v, std::memory_order_relaxed);
+        return old;
+      }
+      return counter.fetch_add(v, std::memory_order_relaxed);
+    }
+
+    const unsigned m_every;
+    Slot           m_slots[MaxThreads + 1];
+  };
+
+  /**
+   * A CycleCounter which is switched off: no counters and no timing,
+   * so that accounted calls compile to the plain block calls.
+   **/
+  template<>
+  class DllExport CycleCounter<false> {
+  public:
+    static const unsigned MaxThreads = CycleAccountingThread::MaxThreads;
+
+    explicit CycleCounter(unsigned = 16) {}
+
+    static inline uint64_t now() {
+      return 0;
+    }
+
+    inline int begin() {
+      return -1;
+    }
+
+    inline void add(int, uint64_t, int) {}
+
+    CycleSnapshot snapshot() const {
+      return CycleSnapshot();
+    }
+
+    void reset() {}
+  };
+
+  /**
+   * Times the enclosing scope (one block call) if the counter samples it
+   **/
+  template<bool Enabled>
+  class DllExport CycleScope {
+  public:
+    CycleScope(CycleCounter<Enabled>& counter, int numSamples)
+        : m_counter(counter), m_numSamples(numSamples), m_slot(counter.begin()),
+          m_start(m_slot >= 0 ? CycleCounter<Enabled>::now() : 0) {}
+
+    ~CycleScope() {
+      if (m_slot >= 0) m_counter.add(m_slot, CycleCounter<Enabled>::now() - m_start, m_numSamples);
+    }
+
+  private:
+    CycleScope(const CycleScope&) = delete;
+    CycleScope& operator=(const CycleScope&) = delete;
+
+    CycleCounter<Enabled>& m_counter;
+    const int              m_numSamples;
+    const int              m_slot;
+    const uint64_t         m_start;
+  };
+
+  /**
+   * Filters a block with any filter which has a block filter() method
+   * and accounts its cost in counter.
+   **/
+  template<class Filter, bool Enabled, typename Sample>
+  inline void filterAccounted(
+      Filter& filter, CycleCounter<Enabled>& counter, const Sample* in, int n, Sample* out) {
+    CycleScope<Enabled> scope(counter, n);
+    filter.filter(in, n, out);
+  }
+
+}  // namespace Iir
+
+#endif
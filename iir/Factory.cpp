@@ -0,0 +1,464 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "Factory.h"
+
+#include "Butterworth.h"
+#include "ChebyshevI.h"
+#include "ChebyshevII.h"
+#include "Common.h"
+#include "Custom.h"
+#include "RBJ.h"
+
+#include <cctype>
+#include <cstdio>
+
+namespace Iir {
+
+  static const char* const knownKeys[] = {
+      "order", "fs", "fc", "bw", "gain", "ripple", "stopband", "q", "slope",
+      "scale", "pole", "zero", "polerho", "poletheta", "zerorho", "zerotheta"};
+
+  static std::string normalise(const std::string& s) {
+    std::string r;
+    for (char c : s)
+      if (!isspace(static_cast<unsigned char>(c)))
+        r += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return r;
+  }
+
+  static std::string invalidSpec(const std::string& spec, const std::string& reason) {
+    return "Invalid filter specification '" + spec + "': " + reason;
+  }
+
+  FilterSpec FilterSpec::parse(const std::string& spec) {
+    FilterSpec  r;
+    std::string s = normalise(spec);
+    int         field = 0;
+    size_t      begin = 0;
+    while (begin <= s.size()) {
+      size_t end = s.find(':', begin);
+      if (end == std::string::npos) end = s.size();
+      const std::string token = s.substr(begin, end - begin);
+      if (token.empty()) throw std::invalid_argument(invalidSpec(spec, "empty field."));
+      if (field == 0) {
+        r.m_family = token;
+      } else if (field == 1) {
+        r.m_type = token;
+      } else {
+        const size_t eq = token.find('=');
+        if (eq == std::string::npos)
+          throw std::invalid_argument(invalidSpec(spec, "expected key=value."));
+        const std::string key   = token.substr(0, eq);
+        const std::string value = token.substr(eq + 1);
+        bool              known = false;
+        for (const char* k : knownKeys)
+          known = known || (key == k);
+        if (!known) throw std::invalid_argument(invalidSpec(spec, "unknown key '" + key + "'."));
+        if (r.has(key))
+          throw std::invalid_argument(invalidSpec(spec, "key '" + key + "' given twice."));
+        char*        last = nullptr;
+        const double v    = strtod(value.c_str(), &last);
+        if (value.empty() || (*last != 0) || !std::isfinite(v))
+          throw std::invalid_argument(invalidSpec(spec, "invalid value of '" + key + "'."));
+        r.m_values[key] = v;
+      }
+      field++;
+      begin = end + 1;
+    }
+    if (field < 2) throw std::invalid_argument(invalidSpec(spec, "expected family:type."));
+    return r;
+  }
+
+  double FilterSpec::get(const std::string& key) const {
+    const auto i = m_values.find(key);
+    if (i == m_values.end())
+      throw std::invalid_argument(
+          "The filter specification " + toString() + " needs the key '" + key + "'.");
+    return i->second;
+  }
+
+  double FilterSpec::get(const std::string& key, double defaultValue) const {
+    const auto i = m_values.find(key);
+    return (i == m_values.end()) ? defaultValue : i->second;
+  }
+
+  std::string FilterSpec::toString() const {
+    std::string s = m_family + ":" + m_type;
+    for (const auto& kv : m_values) {
+      char value[32];
+      snprintf(value, sizeof(value), "%.17g", kv.second);
+      s += ":" + kv.first + "=" + value;
+    }
+    return s;
+  }
+
+  //------------------------------------------------------------------------------
+
+  // instantiates the filter with the smallest template order which fits
+  template<template<unsigned int, class> class Filter, class Design>
+  static AnyFilter designOrder(int order, Design design) {
+    AnyFilter any;
+    if (order < 1) throw std::invalid_argument("The filter order needs to be at least one.");
+    if (order <= 2)
+      design(any.emplace<Filter<2, DEFAULT_STATE>>());
+    else if (order <= 4)
+      design(any.emplace<Filter<4, DEFAULT_STATE>>());
+    else if (order <= 8)
+      design(any.emplace<Filter<8, DEFAULT_STATE>>());
+    else if (order <= 16)
+      design(any.emplace<Filter<16, DEFAULT_STATE>>());
+    else
+      throw std::invalid_argument(orderTooHigh);
+    any.reset();
+    return any;
+  }
+
+  template<class Filter, class Design>
+  static AnyFilter designBiquad(Design design) {
+    AnyFilter any;
+    design(any.emplace<Filter>());
+    any.reset();
+    return any;
+  }
+
+  static int getOrder(const FilterSpec& spec) {
+    const double order = spec.get("order");
+    if (order != floor(order))
+      throw std::invalid_argument("The filter order needs to be an integer.");
+    // range check before the conversion to int
+    if (order < 1) throw std::invalid_argument("The filter order needs to be at least one.");
+    if (order > 16) throw std::invalid_argument(orderTooHigh);
+    return static_cast<int>(order);
+  }
+
+  static std::string unknownType(const FilterSpec& spec) {
+    return "Unknown filter type '" + spec.getType() + "' of the family '" + spec.getFamily() +
+           "'.";
+  }
+
+  // rejects all keys which the filter type does not use
+  template<class IsUsed>
+  static void checkKeys(const FilterSpec& spec, IsUsed isUsed) {
+    for (const char* key : knownKeys)
+      if (spec.has(key) && !isUsed(std::string(key)))
+        throw std::invalid_argument("The key '" + std::string(key) + "' is not used by " +
+                                    spec.getFamily() + ":" + spec.getType() + ".");
+  }
+
+  // keys of the Butterworth and Chebyshev filters, designKey is ripple or stopband
+  static void checkPoleFilterKeys(const FilterSpec& spec, const char* designKey) {
+    const std::string& t     = spec.getType();
+    const bool         band  = (t == "bandpass") || (t == "bandstop") || (t == "bandshelf");
+    const bool         shelf = (t == "lowshelf") || (t == "highshelf") || (t == "bandshelf");
+    checkKeys(spec, [&](const std::string& key) {
+      return (key == "order") || (key == "fs") || (key == "fc") || (band && (key == "bw")) ||
+             (shelf && (key == "gain")) || (designKey && (key == designKey));
+    });
+  }
+
+  static void checkRBJKeys(const FilterSpec& spec) {
+    const std::string& t = spec.getType();
+    checkKeys(spec, [&](const std::string& key) {
+      if ((key == "fs") || (key == "fc")) return true;
+      if (key == "q") return (t == "lowpass") || (t == "highpass") || (t == "iirnotch") ||
+                             (t == "allpass");
+      if (key == "slope") return (t == "lowshelf") || (t == "highshelf");
+      if (key == "gain") return (t == "lowshelf") || (t == "highshelf") || (t == "bandshelf");
+      if (key == "bw") return (t == "bandpass1") || (t == "bandpass2") || (t == "bandstop") ||
+                              (t == "bandshelf");
+      return false;
+    });
+  }
+
+  static void checkCustomKeys(const FilterSpec& spec) {
+    const std::string& t = spec.getType();
+    checkKeys(spec, [&](const std::string& key) {
+      if (key == "scale") return true;
+      if ((key == "pole") || (key == "zero")) return t == "onepole";
+      return (t == "twopole") && ((key == "polerho") || (key == "poletheta") ||
+                                  (key == "zerorho") || (key == "zerotheta"));
+    });
+  }
+
+  FilterSpec FilterSpec::canonical() const {
+    FilterSpec         r(*this);
+    const std::string& t = m_type;
+    if (m_family == "butterworth") {
+      checkPoleFilterKeys(*this, nullptr);
+    } else if ((m_family == "chebyshev1") || (m_family == "chebyshevi")) {
+      checkPoleFilterKeys(*this, "ripple");
+      r.m_family = "chebyshev1";
+    } else if ((m_family == "chebyshev2") || (m_family == "chebyshevii")) {
+      checkPoleFilterKeys(*this, "stopband");
+      r.m_family = "chebyshev2";
+    } else if (m_family == "rbj") {
+      checkRBJKeys(*this);
+      if ((t == "lowpass") || (t == "highpass") || (t == "allpass"))
+        r.m_values["q"] = get("q", ONESQRT2);
+      if (t == "iirnotch") r.m_values["q"] = get("q", 10);
+      if ((t == "lowshelf") || (t == "highshelf")) r.m_values["slope"] = get("slope", 1);
+    } else if (m_family == "custom") {
+      checkCustomKeys(*this);
+      r.m_values["scale"] = get("scale", 1);
+    } else {
+      throw std::invalid_argument("Unknown filter family '" + m_family + "'.");
+    }
+
+    // the width of the rbj filters is in octaves
+    const double fs = get("fs", 1);
+    if (!(fs > 0)) throw std::invalid_argument("The sampling rate needs to be positive.");
+    r.m_values.erase("fs");
+    if (has("fc")) r.m_values["fc"] = get("fc") / fs;
+    if (has("bw") && (r.m_family != "rbj")) r.m_values["bw"] = get("bw") / fs;
+    return r;
+  }
+
+  // the designs get canonical specifications with normalised frequencies
+
+  static AnyFilter makeButterworth(const FilterSpec& spec) {
+    using namespace Butterworth;
+    const std::string& t     = spec.getType();
+    const int          order = getOrder(spec);
+    const double       fc    = spec.get("fc");
+    if (t == "lowpass")
+      return designOrder<LowPass>(order, [&](LowPassBase& f) { f.setup(order, fc); });
+    if (t == "highpass")
+      return designOrder<HighPass>(order, [&](HighPassBase& f) { f.setup(order, fc); });
+    if (t == "lowshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<LowShelf>(order, [&](LowShelfBase& f) { f.setup(order, fc, gain); });
+    }
+    if (t == "highshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<HighShelf>(order, [&](HighShelfBase& f) { f.setup(order, fc, gain); });
+    }
+    const double bw = spec.get("bw");
+    if (t == "bandpass")
+      return designOrder<BandPass>(order, [&](BandPassBase& f) { f.setup(order, fc, bw); });
+    if (t == "bandstop")
+      return designOrder<BandStop>(order, [&](BandStopBase& f) { f.setup(order, fc, bw); });
+    if (t == "bandshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<BandShelf>(
+          order, [&](BandShelfBase& f) { f.setup(order, fc, bw, gain); });
+    }
+    throw std::invalid_argument(unknownType(spec));
+  }
+
+  static AnyFilter makeChebyshevI(const FilterSpec& spec) {
+    using namespace ChebyshevI;
+    const std::string& t      = spec.getType();
+    const int          order  = getOrder(spec);
+    const double       fc     = spec.get("fc");
+    const double       ripple = spec.get("ripple");
+    if (t == "lowpass")
+      return designOrder<LowPass>(order, [&](LowPassBase& f) { f.setup(order, fc, ripple); });
+    if (t == "highpass")
+      return designOrder<HighPass>(order, [&](HighPassBase& f) { f.setup(order, fc, ripple); });
+    if (t == "lowshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<LowShelf>(
+          order, [&](LowShelfBase& f) { f.setup(order, fc, gain, ripple); });
+    }
+    if (t == "highshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<HighShelf>(
+          order, [&](HighShelfBase& f) { f.setup(order, fc, gain, ripple); });
+    }
+    const double bw = spec.get("bw");
+    if (t == "bandpass")
+      return designOrder<BandPass>(
+          order, [&](BandPassBase& f) { f.setup(order, fc, bw, ripple); });
+    if (t == "bandstop")
+      return designOrder<BandStop>(
+          order, [&](BandStopBase& f) { f.setup(order, fc, bw, ripple); });
+    if (t == "bandshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<BandShelf>(
+          order, [&](BandShelfBase& f) { f.setup(order, fc, bw, gain, ripple); });
+    }
+    throw std::invalid_argument(unknownType(spec));
+  }
+
+  static AnyFilter makeChebyshevII(const FilterSpec& spec) {
+    using namespace ChebyshevII;
+    const std::string& t        = spec.getType();
+    const int          order    = getOrder(spec);
+    const double       fc       = spec.get("fc");
+    const double       stopBand = spec.get("stopband");
+    if (t == "lowpass")
+      return designOrder<LowPass>(order, [&](LowPassBase& f) { f.setup(order, fc, stopBand); });
+    if (t == "highpass")
+      return designOrder<HighPass>(
+          order, [&](HighPassBase& f) { f.setup(order, fc, stopBand); });
+    if (t == "lowshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<LowShelf>(
+          order, [&](LowShelfBase& f) { f.setup(order, fc, gain, stopBand); });
+    }
+    if (t == "highshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<HighShelf>(
+          order, [&](HighShelfBase& f) { f.setup(order, fc, gain, stopBand); });
+    }
+    const double bw = spec.get("bw");
+    if (t == "bandpass")
+      return designOrder<BandPass>(
+          order, [&](BandPassBase& f) { f.setup(order, fc, bw, stopBand); });
+    if (t == "bandstop")
+      return designOrder<BandStop>(
+          order, [&](BandStopBase& f) { f.setup(order, fc, bw, stopBand); });
+    if (t == "bandshelf") {
+      const double gain = spec.get("gain");
+      return designOrder<BandShelf>(
+          order, [&](BandShelfBase& f) { f.setup(order, fc, bw, gain, stopBand); });
+    }
+    throw std::invalid_argument(unknownType(spec));
+  }
+
+  static AnyFilter makeRBJ(const FilterSpec& spec) {
+    using namespace RBJ;
+    const std::string& t  = spec.getType();
+    const double       fc = spec.get("fc");
+    if (t == "lowpass") {
+      const double q = spec.get("q");
+      return designBiquad<LowPass>([&](LowPass& f) { f.setupN(fc, q); });
+    }
+    if (t == "highpass") {
+      const double q = spec.get("q");
+      return designBiquad<HighPass>([&](HighPass& f) { f.setupN(fc, q); });
+    }
+    if (t == "iirnotch") {
+      const double q = spec.get("q");
+      return designBiquad<IIRNotch>([&](IIRNotch& f) { f.setupN(fc, q); });
+    }
+    if (t == "allpass") {
+      const double q = spec.get("q");
+      return designBiquad<AllPass>([&](AllPass& f) { f.setupN(fc, q); });
+    }
+    if (t == "lowshelf") {
+      const double gain = spec.get("gain"), slope = spec.get("slope");
+      return designBiquad<LowShelf>([&](LowShelf& f) { f.setupN(fc, gain, slope); });
+    }
+    if (t == "highshelf") {
+      const double gain = spec.get("gain"), slope = spec.get("slope");
+      return designBiquad<HighShelf>([&](HighShelf& f) { f.setupN(fc, gain, slope); });
+    }
+    const double bw = spec.get("bw");
+    if (t == "bandpass1") return designBiquad<BandPass1>([&](BandPass1& f) { f.setupN(fc, bw); });
+    if (t == "bandpass2") return designBiquad<BandPass2>([&](BandPass2& f) { f.setupN(fc, bw); });
+    if (t == "bandstop") return designBiquad<BandStop>([&](BandStop& f) { f.setupN(fc, bw); });
+    if (t == "bandshelf") {
+      const double gain = spec.get("gain");
+      return designBiquad<BandShelf>([&](BandShelf& f) { f.setupN(fc, gain, bw); });
+    }
+    throw std::invalid_argument(unknownType(spec));
+  }
+
+  // the single biquads of Custom are run as a cascade of one stage
+  static AnyFilter designCustom(const Biquad& b) {
+    const double sos[1][6] = {{b.m_b0, b.m_b1, b.m_b2, 1, b.m_a1, b.m_a2}};
+    AnyFilter    any;
+    any.emplace<Custom::SOSCascade<1, DEFAULT_STATE>>(sos);
+    return any;
+  }
+
+  static AnyFilter makeCustom(const FilterSpec& spec) {
+    const std::string& t     = spec.getType();
+    const double       scale = spec.get("scale");
+    if (t == "onepole") {
+      Custom::OnePole f;
+      f.setup(scale, spec.get("pole"), spec.get("zero"));
+      return designCustom(f);
+    }
+    if (t == "twopole") {
+      Custom::TwoPole f;
+      f.setup(scale, spec.get("polerho"), spec.get("poletheta"), spec.get("zerorho"),
+              spec.get("zerotheta"));
+      return designCustom(f);
+    }
+    throw std::invalid_argument(unknownType(spec));
+  }
+
+  AnyFilter makeFilter(const FilterSpec& spec) {
+    const FilterSpec   c      = spec.canonical();
+    const std::string& family = c.getFamily();
+    if (family == "butterworth") return makeButterworth(c);
+    if (family == "chebyshev1") return makeChebyshevI(c);
+    if (family == "chebyshev2") return makeChebyshevII(c);
+    if (family == "rbj") return makeRBJ(c);
+    return makeCustom(c);
+  }
+
+  //------------------------------------------------------------------------------
+
+  FilterFactory::FilterFactory(int maxDesigns) : m_maxDesigns(maxDesigns) {
+    if (maxDesigns < 1) throw std::invalid_argument("The cache needs space for one design.");
+  }
+
+  AnyFilter FilterFactory::create(const std::string& spec) {
+    // nothing is cached before the design has succeeded
+    const FilterSpec  canonical = FilterSpec::parse(spec).canonical();
+    const std::string key       = canonical.toString();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        d = m_designs.find(key);
+    if (d != m_designs.end()) {
+      // the most recently used design is at the front
+      m_recent.splice(m_recent.begin(), m_recent, d->second);
+      return d->second->second;
+    }
+    m_recent.emplace_front(key, makeFilter(canonical));
+    m_designs[key] = m_recent.begin();
+    if (static_cast<int>(m_designs.size()) > m_maxDesigns) {
+      m_designs.erase(m_recent.back().first);
+      m_recent.pop_back();
+    }
+    return m_recent.front().second;
+  }
+
+  int FilterFactory::getCacheSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_designs.size());
+  }
+
+  void FilterFactory::clearCache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_designs.clear();
+    m_recent.clear();
+  }
+
+}  // namespace Iir
@@ -0,0 +1,205 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_FACTORY_H
+#define IIR1_FACTORY_H
+
+#include "AnyFilter.h"
+#include "Common.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace Iir {
+
+  /**
+   * Parsed filter specification of the form
+   * family:type[:key=value]...
+   * for example "butterworth:bandstop:order=4:fc=50:bw=5:fs=1000".
+   *
+   * Families and types:
+   * - butterworth, chebyshev1, chebyshev2: lowpass, highpass, bandpass,
+   *   bandstop, lowshelf, highshelf, bandshelf
+   * - rbj: lowpass, highpass, bandpass1, bandpass2, bandstop, iirnotch,
+   *   lowshelf, highshelf, bandshelf, allpass
+   * - custom: onepole, twopole
+   *
+   * Custom::SOSCascade is left out: its coefficients are an array and not
+   * a handful of design parameters. Place it into an AnyFilter directly.
+   *
+   * Keys:
+   * - order: filter order (1..16, not for rbj)
+   * - fs: sampling rate (default 1 which makes all frequencies normalised)
+   * - fc: cutoff or centre frequency
+   * - bw: width of the band (in octaves for rbj)
+   * - gain: shelf gain in dB
+   * - ripple: passband ripple in dB (chebyshev1)
+   * - stopband: stopband attenuation in dB (chebyshev2)
+   * - q: quality factor (rbj lowpass, highpass, iirnotch, allpass)
+   * - slope: shelf slope (rbj lowshelf, highshelf)
+   * - scale: gain of the custom filters (default 1)
+   * - pole, zero: real pole and zero (custom onepole)
+   * - polerho, poletheta, zerorho, zerotheta: pole and zero in polar
+   *   coordinates, the angles in radians (custom twopole)
+   *
+   * Names and keys are case insensitive and whitespace is ignored.
+   * makeFilter() rejects keys which the filter type does not use.
+   **/
+  class DllExport FilterSpec {
+  public:
+    /**
+     * Parses a specification. Throws std::invalid_argument if the
+     * syntax is wrong or a key is unknown.
+     * \param spec Specification string
+     **/
+    static FilterSpec parse(const std::string& spec);
+
+    /**
+     * Returns the filter family, for example "butterworth"
+     **/
+    const std::string& getFamily() const {
+      return m_family;
+    }
+
+    /**
+     * Returns the filter type, for example "bandstop"
+     **/
+    const std::string& getType() const {
+      return m_type;
+    }
+
+    /**
+     * Returns true if the key has been provided
+     **/
+    bool has(const std::string& key) const {
+      return m_values.find(key) != m_values.end();
+    }
+
+    /**
+     * Returns the value of a key. Throws std::invalid_argument
+     * if the key has not been provided.
+     **/
+    double get(const std::string& key) const;
+
+    /**
+     * Returns the value of a key or a default if it has not been provided
+     **/
+    double get(const std::string& key, double defaultValue) const;
+
+    /**
+     * Returns the specification as a string (lower case, sorted
+     * keys, full precision).
+     **/
+    std::string toString() const;
+
+    /**
+     * Returns the canonical form of the specification: the defaults are
+     * filled in, the frequencies are normalised by fs (which is then
+     * dropped) and the family has one name, so that all specifications
+     * of the same filter have the same toString(). Throws
+     * std::invalid_argument if the family is unknown or a key is not
+     * used by the filter type.
+     **/
+    FilterSpec canonical() const;
+
+  private:
+    std::string                   m_family;
+    std::string                   m_type;
+    std::map<std::string, double> m_values;
+  };
+
+  /**
+   * Designs the filter of a specification. The template is chosen
+   * with the smallest of the orders 2, 4, 8 or 16 which fits the
+   * requested order so that common filters fit into the buffer of
+   * the AnyFilter.
+   * \param spec Parsed specification
+   **/
+  DllExport AnyFilter makeFilter(const FilterSpec& spec);
+
+  /**
+   * Designs the filter of a specification string
+   * \param spec Specification, for example "rbj:iirnotch:fc=50:q=10:fs=1000"
+   **/
+  inline AnyFilter makeFilter(const std::string& spec) {
+    return makeFilter(FilterSpec::parse(spec));
+  }
+
+  /**
+   * Creates filters from specification strings and keeps the designs.
+   * A filter which has been designed before is not designed again, even
+   * if its specification is written differently (see FilterSpec::canonical()):
+   * it is copied from the cache with its delay lines cleared. The cache
+   * keeps up to maxDesigns filters and drops the least recently used one.
+   * The factory can be used from different threads.
+   **/
+  class DllExport FilterFactory {
+  public:
+    /**
+     * \param maxDesigns Number of designs which are kept
+     **/
+    explicit FilterFactory(int maxDesigns = 256);
+
+    /**
+     * Returns a new filter for a specification
+     * \param spec Specification, for example "butterworth:lowpass:order=8:fc=100:fs=1000"
+     **/
+    AnyFilter create(const std::string& spec);
+
+    /**
+     * Returns the number of designs in the cache
+     **/
+    int getCacheSize() const;
+
+    /**
+     * Removes all designs from the cache
+     **/
+    void clearCache();
+
+  private:
+    typedef std::list<std::pair<std::string, AnyFilter>> Designs;
+
+    const int                                m_maxDesigns;
+    mutable std::mutex                       m_mutex;
+    Designs                                  m_recent;
+    std::map<std::string, Designs::iterator> m_designs;
+  };
+
+}  // namespace Iir
+
+#endif
@@ -0,0 +1,186 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "FilterBank.h"
+
+#include "Common.h"
+
+namespace Iir {
+
+  static const char tooManyBands[] =
+      "Requested number of bands is too high. Provide a higher number of bands for the template.";
+  static const char bandIndexOutOfBounds[] = "Band index out of bounds.";
+  static const char bandEdgeError[] = "The band edges need to be between 0 and the Nyquist frequency.";
+
+  FilterBankBase::FilterBankBase()
+      : m_numBands(0), m_maxBands(0), m_numStages(0), m_coefficients(0), m_edges(0) {}
+
+  void FilterBankBase::setBankStorage(const Storage& storage) {
+    m_numBands     = 0;
+    m_maxBands     = storage.maxBands;
+    m_numStages    = storage.numStages;
+    m_coefficients = storage.coefficients;
+    m_edges        = storage.edges;
+    setupLanes(0);
+  }
+
+  void FilterBankBase::rebindBankStorage(const Storage& storage) {
+    m_maxBands     = storage.maxBands;
+    m_numStages    = storage.numStages;
+    m_coefficients = storage.coefficients;
+    m_edges        = storage.edges;
+  }
+
+  double FilterBankBase::getCenterFrequency(int band) const {
+    return sqrt(getLowerEdge(band) * getUpperEdge(band));
+  }
+
+  double FilterBankBase::getLowerEdge(int band) const {
+    if ((band < 0) || (band >= m_numBands)) throw std::invalid_argument(bandIndexOutOfBounds);
+    return m_edges[band];
+  }
+
+  double FilterBankBase::getUpperEdge(int band) const {
+    if ((band < 0) || (band >= m_numBands)) throw std::invalid_argument(bandIndexOutOfBounds);
+    return m_edges[m_maxBands + band];
+  }
+
+  complex_t FilterBankBase::response(int band, double normalizedFrequency) const {
+    if ((band < 0) || (band >= m_numBands)) throw std::invalid_argument(bandIndexOutOfBounds);
+
+    const double    w    = 2 * doublePi * normalizedFrequency;
+    const complex_t czn1 = std::polar(1., -w);
+    const complex_t czn2 = std::polar(1., -2 * w);
+    complex_t       ch(1);
+    complex_t       cbot(1);
+
+    for (int s = 0; s < m_numStages; s++) {
+      const double* c = m_coefficients + s * 5 * m_maxBands + band;
+      complex_t     ct(c[0]);
+      complex_t     cb(1);
+      ct = addmul(ct, c[m_maxBands], czn1);
+      ct = addmul(ct, c[2 * m_maxBands], czn2);
+      cb = addmul(cb, c[3 * m_maxBands], czn1);
+      cb = addmul(cb, c[4 * m_maxBands], czn2);
+      ch *= ct;
+      cbot *= cb;
+    }
+
+    return ch / cbot;
+  }
+
+  void FilterBankBase::setupBands(
+      double sampleRate, int bandsPerOctave, double minFrequency, double maxFrequency) {
+    if (bandsPerOctave < 1) throw std::invalid_argument("At least one band per octave required.");
+    if (!(minFrequency > 0) || (maxFrequency < minFrequency))
+      throw std::invalid_argument("Invalid frequency range of the filter bank.");
+
+    // ANSI S1.11: octave ratio G and reference frequency fr
+    const double G  = pow(10., 3. / 10.);
+    const double fr = 1000;
+    const double b  = bandsPerOctave;
+
+    // exact mid-band frequency is fr * G^(e/b) where the exponent e is
+    // an integer for odd b and an odd multiple of 1/2 for even b
+    const double offset = (bandsPerOctave & 1) ? 0 : 0.5;
+    const int    kmin   = (int) floor(b * log(minFrequency / fr) / log(G) - offset + 0.5);
+    const int    kmax   = (int) floor(b * log(maxFrequency / fr) / log(G) - offset + 0.5);
+
+    const int numBands = kmax - kmin + 1;
+    if (numBands > m_maxBands) throw std::invalid_argument(tooManyBands);
+    if (numBands < 1) throw std::invalid_argument("No band within the frequency range.");
+
+    const double halfBand = pow(G, 1. / (2 * b));
+    for (int i = 0; i < numBands; i++) {
+      const double fm         = fr * pow(G, (kmin + i + offset) / b);
+      m_edges[i]              = fm / halfBand / sampleRate;
+      m_edges[m_maxBands + i] = fm * halfBand / sampleRate;
+    }
+
+    setupLanes(numBands);
+  }
+
+  void FilterBankBase::setupBands(int numBands, const double* lowerEdges, const double* upperEdges) {
+    if (numBands > m_maxBands) throw std::invalid_argument(tooManyBands);
+    if (numBands < 0) throw std::invalid_argument(bandIndexOutOfBounds);
+
+    for (int band = 0; band < numBands; band++) {
+      m_edges[band]              = lowerEdges[band];
+      m_edges[m_maxBands + band] = upperEdges[band];
+    }
+
+    setupLanes(numBands);
+  }
+
+  void FilterBankBase::setupLanes(int numBands) {
+    m_numBands = 0;
+    for (int band = 0; band < numBands; band++) {
+      const double lower = m_edges[band];
+      const double upper = m_edges[m_maxBands + band];
+      if (!(lower > 0) || !(upper < 0.5) || !(lower < upper))
+        throw std::invalid_argument(bandEdgeError);
+    }
+    m_numBands = numBands;
+
+    // unused lanes are set to pass through
+    for (int s = 0; s < m_numStages; s++) {
+      double* c = m_coefficients + s * 5 * m_maxBands;
+      for (int band = 0; band < m_maxBands; band++) {
+        c[band]                  = 1;
+        c[m_maxBands + band]     = 0;
+        c[2 * m_maxBands + band] = 0;
+        c[3 * m_maxBands + band] = 0;
+        c[4 * m_maxBands + band] = 0;
+      }
+    }
+  }
+
+  void FilterBankBase::setBandCoefficients(int band, const Cascade::Storage& design) {
+    if ((band < 0) || (band >= m_numBands)) throw std::invalid_argument(bandIndexOutOfBounds);
+    if (design.maxStages > m_numStages)
+      throw std::invalid_argument("Number of stages is larger than the max stages.");
+
+    for (int s = 0; s < design.maxStages; s++) {
+      const Biquad& stage = design.stageArray[s];
+      double*       c     = m_coefficients + s * 5 * m_maxBands + band;
+      c[0]                = stage.m_b0;
+      c[m_maxBands]       = stage.m_b1;
+      c[2 * m_maxBands]   = stage.m_b2;
+      c[3 * m_maxBands]   = stage.m_a1;
+      c[4 * m_maxBands]   = stage.m_a2;
+    }
+  }
+
+}  // namespace Iir
@@ -0,0 +1,450 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_FILTERBANK_H
+#define IIR1_FILTERBANK_H
+
+#include "Butterworth.h"
+#include "Cascade.h"
+#include "Common.h"
+#include "MathSupplement.h"
+
+#include <stdexcept>
+
+namespace Iir {
+
+  /**
+   * Factored implementation of the fractional-octave filter bank which
+   * does not depend on the number of bands or the filter order.
+   * The coefficients and the states are kept band-major in arrays
+   * which are provided by the template FilterBank: for every biquad
+   * stage the coefficients of all bands are contiguous so that the
+   * inner loop over the bands maps onto SIMD lanes.
+   **/
+  class DllExport FilterBankBase {
+  public:
+    /**
+     * Pointers to the band-major arrays of the FilterBank
+     **/
+    struct DllExport Storage {
+      /**
+       * \param maxBands_ Number of bands the arrays can hold
+       * \param numStages_ Number of biquads per band
+       * \param coefficients_ Array of the size [numStages_][5][maxBands_]
+       * \param edges_ Array of the size [2][maxBands_] for the band edges
+       **/
+      Storage(int maxBands_, int numStages_, double* const coefficients_, double* const edges_)
+          : maxBands(maxBands_), numStages(numStages_), coefficients(coefficients_), edges(edges_) {}
+
+      const int     maxBands;
+      const int     numStages;
+      double* const coefficients;
+      double* const edges;
+    };
+
+    /**
+     * Returns the number of bands which have been set up
+     **/
+    int getNumBands() const {
+      return m_numBands;
+    }
+
+    /**
+     * Returns the normalised centre frequency (0..1/2) of a band which is
+     * the geometric mean of its band edges.
+     * \param band Index of the band starting with the lowest one
+     **/
+    double getCenterFrequency(int band) const;
+
+    /**
+     * Returns the normalised lower -3dB edge (0..1/2) of a band
+     * \param band Index of the band starting with the lowest one
+     **/
+    double getLowerEdge(int band) const;
+
+    /**
+     * Returns the normalised upper -3dB edge (0..1/2) of a band
+     * \param band Index of the band starting with the lowest one
+     **/
+    double getUpperEdge(int band) const;
+
+    /**
+     * Calculates the response of one band at the given normalised frequency
+     * \param band Index of the band starting with the lowest one
+     * \param normalizedFrequency Frequency from 0 to 0.5 (Nyquist)
+     **/
+    complex_t response(int band, double normalizedFrequency) const;
+
+  protected:
+    FilterBankBase();
+
+    void setBankStorage(const Storage& storage);
+
+    /**
+     * Points to arrays with a copy of the coefficients and band edges
+     * (for example after copying a bank) and keeps the number of bands.
+     **/
+    void rebindBankStorage(const Storage& storage);
+
+    /**
+     * Calculates the band edges of fractional-octave bands after ANSI S1.11
+     * (base ten) with the reference frequency of 1kHz. All bands with their
+     * centre frequency between minFrequency and maxFrequency are created.
+     **/
+    void setupBands(
+        double sampleRate, int bandsPerOctave, double minFrequency, double maxFrequency);
+
+    /**
+     * Sets the normalised band edges directly. The number of bands
+     * is given by the number of edge pairs.
+     **/
+    void setupBands(int numBands, const double* lowerEdges, const double* upperEdges);
+
+    /**
+     * Copies the coefficients of a designed cascade into the lanes of one band.
+     **/
+    void setBandCoefficients(int band, const Cascade::Storage& design);
+
+  private:
+    void setupLanes(int numBands);
+
+    int     m_numBands;
+    int     m_maxBands;
+    int     m_numStages;
+    double* m_coefficients;
+    double* m_edges;
+  };
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Bank of Butterworth bandpass filters which are all fed with the same
+   * input signal, for example for octave or third-octave analysis.
+   * Instead of running one filter object per band all bands are evaluated
+   * together in one pass: the input sample is loaded once and every
+   * biquad stage is processed for all bands in a loop which the compiler
+   * can vectorise (Direct Form II, band-major state).
+   * \param MaxBands Reserves memory for up to MaxBands bands
+   * \param FilterOrder Order of the Butterworth bandpass prototype per band
+   **/
+  template<unsigned int MaxBands, unsigned int FilterOrder = DEFAULT_FILTER_ORDER>
+  class DllExport FilterBank : public FilterBankBase {
+  public:
+    FilterBank() {
+      setBankStorage(Storage(MaxBands, FilterOrder, &m_coefficients[0][0][0], &m_edges[0][0]));
+      reset();
+    }
+
+    FilterBank(const FilterBank& other) : FilterBankBase(other) {
+      copyArrays(other);
+    }
+
+    FilterBank& operator=(const FilterBank& other) {
+      FilterBankBase::operator=(other);
+      copyArrays(other);
+      return *this;
+    }
+
+    /**
+     * Designs fractional-octave bands after ANSI S1.11 (base ten, 1kHz reference).
+     * All bands with a centre frequency between minFrequency and maxFrequency are created.
+     * \param sampleRate Sampling rate
+     * \param bandsPerOctave 1 for octaves, 3 for third-octaves, ...
+     * \param minFrequency Lowest centre frequency
+     * \param maxFrequency Highest centre frequency
+     **/
+    void setup(double sampleRate, int bandsPerOctave, double minFrequency, double maxFrequency) {
+      setupBands(sampleRate, bandsPerOctave, minFrequency, maxFrequency);
+      design();
+    }
+
+    /**
+     * Designs bands with arbitrary normalised edges (0..1/2).
+     * \param numBands Number of bands
+     * \param lowerEdges Array of numBands lower -3dB edges
+     * \param upperEdges Array of numBands upper -3dB edges
+     **/
+    void setupN(int numBands, const double* lowerEdges, const double* upperEdges) {
+      setupBands(numBands, lowerEdges, upperEdges);
+      design();
+    }
+
+    /**
+     * Resets the delay lines of all bands
+     **/
+    void reset() {
+      for (auto& stage : m_states)
+        for (auto& delay : stage)
+          for (auto& v : delay)
+            v = 0;
+    }
+
+    /**
+     * Filters one sample through all bands.
+     * \param in Sample to be filtered
+     * \param bandOutputs Array receiving getNumBands() filtered samples
+     **/
+    template<typename Sample>
+    inline void filter(const Sample in, Sample* bandOutputs) {
+      double y[MaxBands];
+      process(static_cast<double>(in), y);
+      for (int b = 0; b < getNumBands(); b++)
+        bandOutputs[b] = static_cast<Sample>(y[b]);
+    }
+
+    /**
+     * Filters a block of samples through all bands.
+     * \param input Array of numSamples input samples
+     * \param numSamples Number of samples in the block
+     * \param bandOutputs Array of getNumBands() pointers to arrays of numSamples samples.
+     *        Can be nullptr if only the energies are required.
+     * \param bandEnergies Optional array of getNumBands() values which receives the
+     *        sum of the squared outputs of every band over this block.
+     **/
+    template<typename Sample>
+    void filter(
+        const Sample* input,
+        int           numSamples,
+        Sample* const* bandOutputs,
+        double*       bandEnergies = nullptr) {
+      const int numBands = getNumBands();
+      double    energy[MaxBands] = {};
+      double    y[MaxBands];
+      for (int i = 0; i < numSamples; i++) {
+        process(static_cast<double>(input[i]), y);
+        if (bandOutputs)
+          for (int b = 0; b < numBands; b++)
+            bandOutputs[b][i] = static_cast<Sample>(y[b]);
+        for (unsigned int b = 0; b < MaxBands; b++)
+          energy[b] += y[b] * y[b];
+      }
+      if (bandEnergies)
+        for (int b = 0; b < numBands; b++)
+          bandEnergies[b] = energy[b];
+    }
+
+  private:
+    void design() {
+      Butterworth::BandPass<FilterOrder> prototype;
+      for (int b = 0; b < getNumBands(); b++) {
+        const double lower = getLowerEdge(b);
+        const double upper = getUpperEdge(b);
+        prototype.setupN((lower + upper) / 2, upper - lower);
+        setBandCoefficients(b, prototype.getCascadeStorage());
+      }
+      reset();
+    }
+
+    // Direct Form II for all bands at once
+    inline void process(const double in, double (&y)[MaxBands]) {
+      for (unsigned int b = 0; b < MaxBands; b++)
+        y[b] = in;
+      for (unsigned int s = 0; s < FilterOrder; s++) {
+        const double(&c)[5][MaxBands] = m_coefficients[s];
+        double(&v1)[MaxBands]         = m_states[s][0];
+        double(&v2)[MaxBands]         = m_states[s][1];
+        for (unsigned int b = 0; b < MaxBands; b++) {
+          const double w = y[b] - c[3][b] * v1[b] - c[4][b] * v2[b];
+          y[b]           = c[0][b] * w + c[1][b] * v1[b] + c[2][b] * v2[b];
+          v2[b]          = v1[b];
+          v1[b]          = w;
+        }
+      }
+    }
+
+    void copyArrays(const FilterBank& other) {
+      std::memcpy(m_coefficients, other.m_coefficients, sizeof(m_coefficients));
+      std::memcpy(m_states, other.m_states, sizeof(m_states));
+      std::memcpy(m_edges, other.m_edges, sizeof(m_edges));
+      rebindBankStorage(Storage(MaxBands, FilterOrder, &m_coefficients[0][0][0], &m_edges[0][0]));
+    }
+
+    // per stage: b0, b1, b2, a1, a2 for all bands
+    double m_coefficients[FilterOrder][5][MaxBands];
+    // per stage: v1, v2 for all bands
+    double m_states[FilterOrder][2][MaxBands];
+    // lower and upper band edges
+    double m_edges[2][MaxBands];
+  };
+
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Multirate fractional-octave filter bank. Only the top octave runs at the
+   * full sampling rate. The signal is then lowpass filtered and decimated by
+   * two for every octave below so that all octaves use the same bandpass
+   * coefficients at the same normalised frequencies. This costs about twice
+   * as much as the top octave alone and avoids the very low normalised
+   * cutoffs which are numerically difficult for the low bands.
+   * The octaves have a ratio of exactly two (ANSI S1.11 base two).
+   * \param BandsPerOctave 1 for octaves, 3 for third-octaves, ...
+   * \param NumOctaves Number of octaves
+   * \param FilterOrder Order of the Butterworth bandpass prototype per band
+   * \param AntiAliasOrder Order of the Butterworth anti-alias lowpass
+   **/
+  template<
+      unsigned int BandsPerOctave,
+      unsigned int NumOctaves,
+      unsigned int FilterOrder    = DEFAULT_FILTER_ORDER,
+      unsigned int AntiAliasOrder = 8>
+  class DllExport MultirateFilterBank {
+  public:
+    MultirateFilterBank() {
+      reset();
+    }
+
+    /**
+     * Designs the bands. The highest band is centred at maxFrequency and all
+     * other bands are spaced by 2^(1/BandsPerOctave) below it.
+     * \param sampleRate Sampling rate
+     * \param maxFrequency Centre frequency of the highest band
+     **/
+    void setup(double sampleRate, double maxFrequency) {
+      setupN(maxFrequency / sampleRate);
+    }
+
+    /**
+     * Designs the bands. The highest band is centred at maxFrequency and all
+     * other bands are spaced by 2^(1/BandsPerOctave) below it.
+     * \param maxFrequency Normalised centre frequency of the highest band. Its upper
+     *        band edge should be well below 1/4 for a good rejection of aliases.
+     **/
+    void setupN(double maxFrequency) {
+      const double halfBand = pow(2., 1. / (2 * BandsPerOctave));
+      double       lower[BandsPerOctave];
+      double       upper[BandsPerOctave];
+      for (unsigned int b = 0; b < BandsPerOctave; b++) {
+        const double fm = maxFrequency * pow(2., -(double) (BandsPerOctave - 1 - b) / BandsPerOctave);
+        lower[b]        = fm / halfBand;
+        upper[b]        = fm * halfBand;
+      }
+      // the next octave needs to stay free of aliases after decimation
+      const double pass = upper[BandsPerOctave - 1] / 2;
+      if (!(pass < 0.25))
+        throw std::invalid_argument("The highest band needs to be below the Nyquist frequency.");
+
+      // all octaves share the same normalised design
+      for (auto& octave : m_octaves)
+        octave.setupN(BandsPerOctave, lower, upper);
+      for (auto& antiAlias : m_antiAlias)
+        antiAlias.setupN(sqrt(pass * (0.5 - pass)));
+      reset();
+    }
+
+    /**
+     * Returns the number of bands
+     **/
+    int getNumBands() const {
+      return BandsPerOctave * NumOctaves;
+    }
+
+    /**
+     * Returns the normalised centre frequency of a band.
+     * \param band Index of the band starting with the lowest one
+     **/
+    double getCenterFrequency(int band) const {
+      if ((band < 0) || (band >= getNumBands()))
+        throw std::invalid_argument("Band index out of bounds.");
+      const int octave = NumOctaves - 1 - band / BandsPerOctave;
+      return m_octaves[octave].getCenterFrequency(band % BandsPerOctave) / (1 << octave);
+    }
+
+    /**
+     * Resets the delay lines of all octaves
+     **/
+    void reset() {
+      for (auto& octave : m_octaves)
+        octave.reset();
+      for (auto& antiAlias : m_antiAlias)
+        antiAlias.reset();
+      for (auto& phase : m_phase)
+        phase = 0;
+    }
+
+    /**
+     * Filters a block of samples and integrates the energy of every band.
+     * The energies of the decimated octaves are scaled to the full sampling
+     * rate so that they are directly comparable with the top octave.
+     * \param input Array of numSamples input samples
+     * \param numSamples Number of samples in the block
+     * \param bandEnergies Array of getNumBands() values, starting with the lowest band
+     **/
+    template<typename Sample>
+    void filter(const Sample* input, int numSamples, double* bandEnergies) {
+      for (int b = 0; b < getNumBands(); b++)
+        bandEnergies[b] = 0;
+
+      const int chunkSize = 256;
+      double    buffer[2][chunkSize];
+      double    energies[BandsPerOctave];
+      for (int offset = 0; offset < numSamples; offset += chunkSize) {
+        int n = (numSamples - offset < chunkSize) ? numSamples - offset : chunkSize;
+        for (int i = 0; i < n; i++)
+          buffer[0][i] = static_cast<double>(input[offset + i]);
+
+        double* x = buffer[0];
+        double* y = buffer[1];
+        for (unsigned int o = 0; o < NumOctaves; o++) {
+          m_octaves[o].filter(x, n, (double**) nullptr, energies);
+          double* e = bandEnergies + (NumOctaves - 1 - o) * BandsPerOctave;
+          for (unsigned int b = 0; b < BandsPerOctave; b++)
+            e[b] += energies[b] * (1 << o);
+
+          if (o == NumOctaves - 1) break;
+
+          int m = 0;
+          for (int i = 0; i < n; i++) {
+            const double a = m_antiAlias[o].filter(x[i]);
+            if (m_phase[o] == 0) y[m++] = a;
+            m_phase[o] ^= 1;
+          }
+          double* t = x;
+          x         = y;
+          y         = t;
+          n         = m;
+        }
+      }
+    }
+
+  private:
+    FilterBank<BandsPerOctave, FilterOrder> m_octaves[NumOctaves];
+    Butterworth::LowPass<AntiAliasOrder>    m_antiAlias[NumOctaves > 1 ? NumOctaves - 1 : 1];
+    int                                     m_phase[NumOctaves > 1 ? NumOctaves - 1 : 1];
+  };
+
+}  // namespace Iir
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "Halfband.h"
+
+#include "Common.h"
+
+namespace Iir { namespace Halfband {
+
+  // Design of the elliptic halfband after:
+  // R.A. Valenzuela and A.G. Constantinides, "Digital signal processing
+  // schemes for efficient interpolation and decimation",
+  // IEE Proceedings, vol 130, 1983.
+
+  static const char transitionError[] = "The transition bandwidth needs to be between 0 and 1/2.";
+  static const char tooManyCoefficients[] =
+      "Requested number of coefficients is too high. Provide a higher number for the template.";
+
+  // selectivity k and nome q of the elliptic halfband
+  static void transitionParameters(double transitionBandwidth, double& k, double& q) {
+    if (!(transitionBandwidth > 0) || !(transitionBandwidth < 0.5))
+      throw std::invalid_argument(transitionError);
+
+    k = tan((1 - transitionBandwidth * 2) * doublePi / 4);
+    k *= k;
+    const double kksqrt = pow(1 - k * k, 0.25);
+    const double e      = 0.5 * (1 - kksqrt) / (1 + kksqrt);
+    const double e2     = e * e;
+    const double e4     = e2 * e2;
+    q                   = e * (1 + e4 * (2 + e4 * (15 + 150 * e4)));
+  }
+
+  static double coefficient(int index, double k, double q, int order) {
+    const int c = index + 1;
+
+    double num = 0;
+    double qp  = 1;
+    for (int i = 0, j = 1; qp > 1e-100; ++i, j = -j) {
+      qp = pow(q, i * (i + 1));
+      num += qp * sin((i * 2 + 1) * c * doublePi / order) * j;
+    }
+    num *= pow(q, 0.25);
+
+    double den = 0.5;
+    qp         = 1;
+    for (int i = 1, j = -1; qp > 1e-100; ++i, j = -j) {
+      qp = pow(q, i * i);
+      den += qp * cos(i * 2 * c * doublePi / order) * j;
+    }
+
+    const double ww   = num / den;
+    const double wwsq = ww * ww;
+    const double x    = sqrt((1 - wwsq * k) * (1 - wwsq / k)) / (1 + wwsq);
+    return (1 - x) / (1 + x);
+  }
+
+  HalfbandBase::HalfbandBase() : m_numCoefficients(0), m_maxCoefficients(0), m_coefficients(0) {}
+
+  void HalfbandBase::setCoefficientStorage(int maxCoefficients, double* coefficients) {
+    m_numCoefficients = 0;
+    m_maxCoefficients = maxCoefficients;
+    m_coefficients    = coefficients;
+  }
+
+  void HalfbandBase::rebindCoefficientStorage(int maxCoefficients, double* coefficients) {
+    m_maxCoefficients = maxCoefficients;
+    m_coefficients    = coefficients;
+  }
+
+  double HalfbandBase::getCoefficient(int index) const {
+    if ((index < 0) || (index >= m_numCoefficients))
+      throw std::invalid_argument("Index out of bounds.");
+    return m_coefficients[index];
+  }
+
+  int HalfbandBase::getNumCoefficients(double transitionBandwidth, double stopBandDb) {
+    if (!(stopBandDb > 0)) throw std::invalid_argument("The stopband attenuation needs to be positive.");
+    double k;
+    double q;
+    transitionParameters(transitionBandwidth, k, q);
+
+    const double attn = pow(10., -stopBandDb / 10);
+    const double a    = attn / (1 - attn);
+    int          order = (int) ceil(log(a * a / 16) / log(q));
+    if ((order & 1) == 0) ++order;
+    if (order == 1) order = 3;
+    return (order - 1) / 2;
+  }
+
+  void HalfbandBase::setup(double transitionBandwidth, double stopBandDb) {
+    setup(getNumCoefficients(transitionBandwidth, stopBandDb), transitionBandwidth);
+  }
+
+  void HalfbandBase::setup(int numCoefficients, double transitionBandwidth) {
+    if (numCoefficients > m_maxCoefficients) throw std::invalid_argument(tooManyCoefficients);
+    if (numCoefficients < 1) throw std::invalid_argument("At least one coefficient is required.");
+
+    double k;
+    double q;
+    transitionParameters(transitionBandwidth, k, q);
+
+    const int order = numCoefficients * 2 + 1;
+    for (int i = 0; i < numCoefficients; i++)
+      m_coefficients[i] = coefficient(i, k, q, order);
+    m_numCoefficients = numCoefficients;
+  }
+
+  complex_t HalfbandBase::response(double normalizedFrequency) const {
+    const double    w    = 2 * doublePi * normalizedFrequency;
+    const complex_t czn1 = std::polar(1., -w);
+    const complex_t czn2 = std::polar(1., -2 * w);
+    complex_t       a0(1);
+    complex_t       a1(1);
+
+    for (int i = 0; i < m_numCoefficients; i++) {
+      const double    c  = m_coefficients[i];
+      const complex_t ap = (c + czn2) / (1. + c * czn2);
+      if (i & 1)
+        a1 *= ap;
+      else
+        a0 *= ap;
+    }
+
+    return (a0 + czn1 * a1) * 0.5;
+  }
+
+}}  // namespace Iir::Halfband
@@ -0,0 +1,271 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_HALFBAND_H
+#define IIR1_HALFBAND_H
+
+#include "Common.h"
+#include "MathSupplement.h"
+
+#include <stdexcept>
+
+namespace Iir {
+
+  /**
+   * Polyphase IIR halfband filters for decimation and interpolation by two.
+   * The halfband lowpass is the sum of two allpass branches which are
+   * chains of first order sections in z^2:
+   *
+   *  H(z) = 1/2 * ( A0(z^2) + z^-1 * A1(z^2) ),  Ak(z^2) = (a + z^-2) / (1 + a * z^-2)
+   *
+   * Because of the z^2 both branches can run at the low sampling rate so that
+   * every section costs one multiplication per low rate sample. The coefficients
+   * are designed as an elliptic halfband after Valenzuela and Constantinides.
+   **/
+  namespace Halfband {
+
+    /**
+     * Factored design which is shared by the decimator and the interpolator.
+     **/
+    class DllExport HalfbandBase {
+    public:
+      /**
+       * Returns the number of allpass coefficients of both branches together
+       **/
+      int getNumCoefficients() const {
+        return m_numCoefficients;
+      }
+
+      /**
+       * Returns an allpass coefficient. Even indices belong to the
+       * undelayed branch and odd ones to the delayed branch.
+       **/
+      double getCoefficient(int index) const;
+
+      /**
+       * Calculates the response of the halfband lowpass at the high sampling rate
+       * \param normalizedFrequency Frequency from 0 to 0.5 (Nyquist of the high rate)
+       **/
+      complex_t response(double normalizedFrequency) const;
+
+      /**
+       * Calculates how many coefficients are required for a given specification.
+       * \param transitionBandwidth Normalised width of the transition band around 1/4 (0..1/2)
+       * \param stopBandDb Attenuation in the stopband in dB
+       **/
+      static int getNumCoefficients(double transitionBandwidth, double stopBandDb);
+
+    protected:
+      HalfbandBase();
+
+      void setCoefficientStorage(int maxCoefficients, double* coefficients);
+
+      /**
+       * Points to an array with a copy of the coefficients (for example
+       * after copying a filter) and keeps the number of coefficients.
+       **/
+      void rebindCoefficientStorage(int maxCoefficients, double* coefficients);
+
+      void setup(double transitionBandwidth, double stopBandDb);
+
+      void setup(int numCoefficients, double transitionBandwidth);
+
+    private:
+      int     m_numCoefficients;
+      int     m_maxCoefficients;
+      double* m_coefficients;
+    };
+
+    //------------------------------------------------------------------------------
+
+    /**
+     * Delay lines of the allpass sections and the polyphase kernel
+     **/
+    template<unsigned int MaxCoefficients>
+    class DllExport HalfbandStages : public HalfbandBase {
+    public:
+      /**
+       * Designs the filter for a given transition band and stopband attenuation
+       * \param sampleRate High sampling rate
+       * \param transitionBandwidth Width of the transition band centred at sampleRate/4
+       * \param stopBandDb Attenuation in the stopband in dB
+       **/
+      void setup(double sampleRate, double transitionBandwidth, double stopBandDb) {
+        setupN(transitionBandwidth / sampleRate, stopBandDb);
+      }
+
+      /**
+       * Designs the filter for a given transition band and stopband attenuation
+       * \param transitionBandwidth Normalised width of the transition band centred at 1/4
+       * \param stopBandDb Attenuation in the stopband in dB
+       **/
+      void setupN(double transitionBandwidth, double stopBandDb) {
+        HalfbandBase::setup(transitionBandwidth, stopBandDb);
+        reset();
+      }
+
+      /**
+       * Designs the filter with a given number of coefficients which then
+       * determines the stopband attenuation.
+       * \param numCoefficients Number of allpass sections of both branches together
+       * \param transitionBandwidth Normalised width of the transition band centred at 1/4
+       **/
+      void setupN(int numCoefficients, double transitionBandwidth) {
+        HalfbandBase::setup(numCoefficients, transitionBandwidth);
+        reset();
+      }
+
+      /**
+       * Resets the delay lines
+       **/
+      void reset() {
+        for (unsigned int i = 0; i < MaxCoefficients; i++) {
+          m_x1[i] = 0;
+          m_y1[i] = 0;
+        }
+      }
+
+    protected:
+      HalfbandStages() {
+        setCoefficientStorage(MaxCoefficients, m_coefficients);
+        reset();
+      }
+
+      HalfbandStages(const HalfbandStages& other) : HalfbandBase(other) {
+        copyArrays(other);
+      }
+
+      HalfbandStages& operator=(const HalfbandStages& other) {
+        HalfbandBase::operator=(other);
+        copyArrays(other);
+        return *this;
+      }
+
+      // runs one branch at the low sampling rate
+      inline double branch(double x, const int first) {
+        const int n = getNumCoefficients();
+        for (int i = first; i < n; i += 2) {
+          const double y = m_coefficients[i] * (x - m_y1[i]) + m_x1[i];
+          m_x1[i]        = x;
+          m_y1[i]        = y;
+          x              = y;
+        }
+        return x;
+      }
+
+    private:
+      void copyArrays(const HalfbandStages& other) {
+        std::memcpy(m_coefficients, other.m_coefficients, sizeof(m_coefficients));
+        std::memcpy(m_x1, other.m_x1, sizeof(m_x1));
+        std::memcpy(m_y1, other.m_y1, sizeof(m_y1));
+        rebindCoefficientStorage(MaxCoefficients, m_coefficients);
+      }
+
+      double m_coefficients[MaxCoefficients];
+      double m_x1[MaxCoefficients];
+      double m_y1[MaxCoefficients];
+    };
+
+    //------------------------------------------------------------------------------
+
+    /**
+     * Halfband lowpass and decimation by two.
+     * \param MaxCoefficients Reserves memory for up to MaxCoefficients allpass sections
+     **/
+    template<unsigned int MaxCoefficients = 8>
+    struct DllExport Decimator : HalfbandStages<MaxCoefficients> {
+      /**
+       * Takes two consecutive samples at the high rate and returns one at the low rate
+       * \param in0 Earlier input sample
+       * \param in1 Later input sample
+       **/
+      template<typename Sample>
+      inline Sample filter(const Sample in0, const Sample in1) {
+        const double y0 = this->branch(static_cast<double>(in1), 0);
+        const double y1 = this->branch(static_cast<double>(in0), 1);
+        return static_cast<Sample>((y0 + y1) * 0.5);
+      }
+
+      /**
+       * Decimates a block of samples
+       * \param input Array of numSamples samples at the high rate
+       * \param numSamples Number of input samples which needs to be even
+       * \param output Array receiving numSamples / 2 samples at the low rate
+       **/
+      template<typename Sample>
+      void filter(const Sample* input, int numSamples, Sample* output) {
+        if (numSamples & 1) throw std::invalid_argument("Number of samples needs to be even.");
+        for (int i = 0; i < numSamples / 2; i++)
+          output[i] = filter(input[2 * i], input[2 * i + 1]);
+      }
+    };
+
+    /**
+     * Interpolation by two and halfband lowpass.
+     * \param MaxCoefficients Reserves memory for up to MaxCoefficients allpass sections
+     **/
+    template<unsigned int MaxCoefficients = 8>
+    struct DllExport Interpolator : HalfbandStages<MaxCoefficients> {
+      /**
+       * Takes one sample at the low rate and creates two at the high rate
+       * \param in Input sample
+       * \param out0 Earlier output sample
+       * \param out1 Later output sample
+       **/
+      template<typename Sample>
+      inline void filter(const Sample in, Sample& out0, Sample& out1) {
+        const double x = static_cast<double>(in);
+        out0           = static_cast<Sample>(this->branch(x, 0));
+        out1           = static_cast<Sample>(this->branch(x, 1));
+      }
+
+      /**
+       * Interpolates a block of samples
+       * \param input Array of numSamples samples at the low rate
+       * \param numSamples Number of input samples
+       * \param output Array receiving 2 * numSamples samples at the high rate
+       **/
+      template<typename Sample>
+      void filter(const Sample* input, int numSamples, Sample* output) {
+        for (int i = 0; i < numSamples; i++)
+          filter(input[i], output[2 * i], output[2 * i + 1]);
+      }
+    };
+
+  }  // namespace Halfband
+
+}  // namespace Iir
+
+#endif
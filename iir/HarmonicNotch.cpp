@@ -0,0 +1,116 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "HarmonicNotch.h"
+
+#include "Common.h"
+
+namespace Iir {
+
+  HarmonicNotchBase::HarmonicNotchBase()
+      : m_numHarmonics(0), m_maxHarmonics(0), m_c(2), m_bandwidth(0), m_rho(0), m_gain(1), m_stages(0) {}
+
+  void HarmonicNotchBase::setNotchStorage(int maxHarmonics, Biquad* stages) {
+    m_numHarmonics = 0;
+    m_maxHarmonics = maxHarmonics;
+    m_stages       = stages;
+  }
+
+  void HarmonicNotchBase::rebindNotchStorage(int maxHarmonics, Biquad* stages) {
+    m_maxHarmonics = maxHarmonics;
+    m_stages       = stages;
+  }
+
+  void HarmonicNotchBase::setup(double fundamental, int numHarmonics, double bandwidth) {
+    if ((numHarmonics < 1) || (numHarmonics > m_maxHarmonics))
+      throw std::invalid_argument(
+          "Requested number of harmonics is too high. Provide a higher number for the template.");
+    if ((fundamental <= 0) || ((fundamental * numHarmonics) >= 0.5))
+      throw std::invalid_argument("All harmonics need to be between 0 and the Nyquist frequency.");
+    if ((bandwidth <= 0) || (bandwidth >= fundamental))
+      throw std::invalid_argument("The width of the notches needs to be less than the fundamental.");
+
+    m_numHarmonics = numHarmonics;
+    m_bandwidth    = bandwidth;
+    m_rho          = exp(-doublePi * bandwidth);
+    // unity gain away from the notches
+    m_gain         = (1 + m_rho * m_rho) / 2;
+    for (int k = 0; k < m_maxHarmonics; k++)
+      m_stages[k].setIdentity();
+    for (int k = 0; k < m_numHarmonics; k++) {
+      m_stages[k].m_a2 = m_rho * m_rho;
+      m_stages[k].m_b0 = m_gain;
+      m_stages[k].m_b2 = m_gain;
+    }
+    setFundamentalN(fundamental);
+  }
+
+  void HarmonicNotchBase::setFundamentalN(double fundamental) {
+    if ((fundamental <= 0) || (fundamental >= 0.5))
+      throw std::invalid_argument("The fundamental needs to be between 0 and the Nyquist frequency.");
+    if ((fundamental * m_numHarmonics) >= 0.5)
+      throw std::invalid_argument("All harmonics need to be between 0 and the Nyquist frequency.");
+    if (m_bandwidth >= fundamental)
+      throw std::invalid_argument("The width of the notches needs to be less than the fundamental.");
+    setFundamentalCoefficient(-2 * cos(2 * doublePi * fundamental));
+  }
+
+  void HarmonicNotchBase::setFundamentalCoefficient(double c) {
+    if ((c < -2) || (c > 2))
+      throw std::invalid_argument("The coefficient needs to be between -2 and 2.");
+    double previous = -2;
+    double current  = c;
+    for (int k = 0; k < m_numHarmonics; k++) {
+      m_stages[k].m_b1 = m_gain * current;
+      m_stages[k].m_a1 = m_rho * current;
+      const double next = -c * current - previous;
+      previous          = current;
+      current           = next;
+    }
+    m_c = c;
+  }
+
+  double HarmonicNotchBase::getFundamental() const {
+    return acos(-m_c / 2) / (2 * doublePi);
+  }
+
+  complex_t HarmonicNotchBase::response(double normalizedFrequency) const {
+    complex_t h(1);
+    for (int k = 0; k < m_numHarmonics; k++)
+      h *= m_stages[k].response(normalizedFrequency);
+    return h;
+  }
+
+}  // namespace Iir
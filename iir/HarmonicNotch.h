@@ -0,0 +1,214 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_HARMONICNOTCH_H
+#define IIR1_HARMONICNOTCH_H
+
+#include "Biquad.h"
+#include "Cascade.h"
+#include "Common.h"
+#include "State.h"
+
+#include <stdexcept>
+
+namespace Iir {
+
+  /**
+   * Design of the HarmonicNotch which does not depend on the template.
+   * Every harmonic k has the notch
+   * H_k(z) = g (1 + c_k z^-1 + z^-2) / (1 + rho c_k z^-1 + rho^2 z^-2)
+   * with c_k = -2 cos(k w0) and g = (1 + rho^2) / 2 for unity gain
+   * between the notches. All notches have the same width and
+   * the c_k are obtained from c_1 with the recurrence
+   * c_(k+1) = -c_1 c_k - c_(k-1) so that retuning the fundamental
+   * needs at most one cos() for all harmonics.
+   **/
+  class DllExport HarmonicNotchBase {
+  public:
+    /**
+     * Returns the normalised fundamental frequency (0..1/2)
+     **/
+    double getFundamental() const;
+
+    /**
+     * Returns the number of harmonics (including the fundamental) which are notched
+     **/
+    int getNumHarmonics() const {
+      return m_numHarmonics;
+    }
+
+    /**
+     * Calculates the response of all notches at the given normalised frequency
+     * \param normalizedFrequency Frequency from 0 to 0.5 (Nyquist)
+     **/
+    complex_t response(double normalizedFrequency) const;
+
+    /**
+     * Moves all notches to the harmonics of a new fundamental frequency.
+     * The delay lines are kept so that the filter can be retuned while running.
+     * Like setup() it throws if the highest harmonic is not below Nyquist or
+     * if the notches are wider than the new fundamental.
+     * \param fundamental Normalised fundamental frequency (0..1/2)
+     **/
+    void setFundamentalN(double fundamental);
+
+    /**
+     * Moves all notches to the harmonics of the fundamental given by
+     * the coefficient c = -2 cos(w0) without any trigonometric function,
+     * for example from AdaptiveNotch::getCoefficient().
+     * Harmonics which end up above Nyquist are aliased.
+     * \param c Coefficient of the fundamental between -2 and 2
+     **/
+    void setFundamentalCoefficient(double c);
+
+  protected:
+    HarmonicNotchBase();
+
+    void setNotchStorage(int maxHarmonics, Biquad* stages);
+
+    /**
+     * Points to an array with a copy of the notches (for example
+     * after copying a filter) and keeps the number of harmonics.
+     **/
+    void rebindNotchStorage(int maxHarmonics, Biquad* stages);
+
+    /**
+     * Designs the notches
+     * \param fundamental Normalised fundamental frequency
+     * \param numHarmonics Number of harmonics including the fundamental
+     * \param bandwidth Normalised -3dB width of every notch
+     **/
+    void setup(double fundamental, int numHarmonics, double bandwidth);
+
+  private:
+    int     m_numHarmonics;
+    int     m_maxHarmonics;
+    double  m_c;
+    double  m_bandwidth;
+    double  m_rho;
+    double  m_gain;
+    Biquad* m_stages;
+  };
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Notches a fundamental frequency and its harmonics, for example 50Hz
+   * mains and its harmonics up to 450Hz in an ECG. All notches are
+   * evaluated as one cascade so that a block is filtered in a single pass
+   * instead of calling one RBJ::IIRNotch after the other. The fundamental
+   * can be retuned while filtering without redesigning every notch.
+   * \param MaxHarmonics Reserves memory for up to MaxHarmonics notches
+   * \param StateType The filter topology: DirectFormI, DirectFormII, ...
+   **/
+  template<unsigned int MaxHarmonics = 10, class StateType = DEFAULT_STATE>
+  class DllExport HarmonicNotch : public HarmonicNotchBase,
+                                  public CascadeStages<MaxHarmonics, StateType> {
+  public:
+    HarmonicNotch() {
+      setNotchStorage(MaxHarmonics, this->getCascadeStorage().stageArray);
+    }
+
+    HarmonicNotch(const HarmonicNotch& other)
+        : HarmonicNotchBase(other), CascadeStages<MaxHarmonics, StateType>(other) {
+      rebindNotchStorage(MaxHarmonics, this->getCascadeStorage().stageArray);
+    }
+
+    HarmonicNotch& operator=(const HarmonicNotch& other) {
+      HarmonicNotchBase::operator=(other);
+      CascadeStages<MaxHarmonics, StateType>::operator=(other);
+      rebindNotchStorage(MaxHarmonics, this->getCascadeStorage().stageArray);
+      return *this;
+    }
+
+    /**
+     * Designs the notches
+     * \param sampleRate Sampling rate
+     * \param fundamental Fundamental frequency, for example 50 or 60
+     * \param numHarmonics Number of notches including the fundamental (up to MaxHarmonics)
+     * \param bandwidth -3dB width of every notch
+     **/
+    void setup(double sampleRate, double fundamental, int numHarmonics, double bandwidth) {
+      setupN(fundamental / sampleRate, numHarmonics, bandwidth / sampleRate);
+    }
+
+    /**
+     * Designs the notches with normalised frequencies (0..1/2)
+     * \param fundamental Fundamental frequency
+     * \param numHarmonics Number of notches including the fundamental (up to MaxHarmonics)
+     * \param bandwidth -3dB width of every notch
+     **/
+    void setupN(double fundamental, int numHarmonics, double bandwidth) {
+      HarmonicNotchBase::setup(fundamental, numHarmonics, bandwidth);
+      this->updateStates();
+      this->reset();
+    }
+
+    /**
+     * Moves all notches to the harmonics of a new fundamental frequency
+     * while filtering.
+     * \param sampleRate Sampling rate
+     * \param fundamental New fundamental frequency
+     **/
+    void setFundamental(double sampleRate, double fundamental) {
+      setFundamentalN(fundamental / sampleRate);
+    }
+
+    /**
+     * Moves all notches to the harmonics of a new fundamental frequency
+     * (see HarmonicNotchBase::setFundamentalN())
+     * \param fundamental Normalised fundamental frequency (0..1/2)
+     **/
+    void setFundamentalN(double fundamental) {
+      HarmonicNotchBase::setFundamentalN(fundamental);
+      this->updateStates();
+    }
+
+    /**
+     * Moves all notches to the harmonics of the fundamental given by
+     * its coefficient (see HarmonicNotchBase::setFundamentalCoefficient())
+     * \param c Coefficient of the fundamental between -2 and 2
+     **/
+    void setFundamentalCoefficient(double c) {
+      HarmonicNotchBase::setFundamentalCoefficient(c);
+      this->updateStates();
+    }
+
+    using HarmonicNotchBase::response;
+  };
+
+}  // namespace Iir
+
+#endif
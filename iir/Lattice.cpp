@@ -0,0 +1,82 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "Lattice.h"
+
+#include "Common.h"
+
+namespace Iir {
+
+  LatticeSection::LatticeSection(const Biquad& s) {
+    if (s.m_a2 == -1) throw std::invalid_argument("The lattice form needs |a2| < 1.");
+    k2 = s.m_a2;
+    k1 = s.m_a1 / (1 + s.m_a2);
+    v2 = s.m_b2;
+    v1 = s.m_b1 - s.m_b2 * s.m_a1;
+    v0 = s.m_b0 - v1 * k1 - v2 * s.m_a2;
+  }
+
+  void LatticeSection::toBiquad(Biquad& s) const {
+    const double a1 = k1 * (1 + k2);
+    const double a2 = k2;
+    s.setCoefficients(1, a1, a2, v0 + v1 * k1 + v2 * a2, v1 + v2 * a1, v2);
+  }
+
+  LatticeSection LatticeSection::interpolate(
+      const LatticeSection& from, const LatticeSection& to, double t) {
+    LatticeSection s;
+    s.k1 = from.k1 + t * (to.k1 - from.k1);
+    s.k2 = from.k2 + t * (to.k2 - from.k2);
+    s.v0 = from.v0 + t * (to.v0 - from.v0);
+    s.v1 = from.v1 + t * (to.v1 - from.v1);
+    s.v2 = from.v2 + t * (to.v2 - from.v2);
+    return s;
+  }
+
+  bool toLattice(const Cascade::Storage& cascade, LatticeSection* sections) {
+    bool stable = true;
+    for (int i = 0; i < cascade.maxStages; i++) {
+      sections[i] = LatticeSection(cascade.stageArray[i]);
+      stable      = stable && sections[i].isStable();
+    }
+    return stable;
+  }
+
+  void fromLattice(const LatticeSection* sections, const Cascade::Storage& cascade) {
+    for (int i = 0; i < cascade.maxStages; i++)
+      sections[i].toBiquad(cascade.stageArray[i]);
+  }
+
+}  // namespace Iir
@@ -0,0 +1,217 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_LATTICE_H
+#define IIR1_LATTICE_H
+
+#include "Biquad.h"
+#include "Cascade.h"
+#include "Common.h"
+#include "State.h"
+
+#include <algorithm>
+
+namespace Iir {
+
+  /**
+   * Second order section in the lattice-ladder (Gray-Markel) form with
+   * the reflection coefficients k1, k2 and the ladder coefficients v0, v1, v2:
+   *
+   *  k2 = a2, k1 = a1 / (1 + a2)
+   *  v2 = b2, v1 = b1 - b2*a1, v0 = b0 - v1*k1 - v2*a2
+   *
+   * The section is stable if |k1| < 1 and |k2| < 1. Because of this the
+   * linear interpolation between two stable sections is always stable
+   * which makes it safe to modulate filters at block rate.
+   **/
+  struct DllExport LatticeSection {
+    double k1 = 0;
+    double k2 = 0;
+    double v0 = 1;
+    double v1 = 0;
+    double v2 = 0;
+
+    LatticeSection() = default;
+
+    /**
+     * Converts a biquad to the lattice-ladder form
+     **/
+    explicit LatticeSection(const Biquad& s);
+
+    /**
+     * Converts the section back into a biquad
+     **/
+    void toBiquad(Biquad& s) const;
+
+    /**
+     * Returns true if both reflection coefficients are smaller than one
+     **/
+    bool isStable() const {
+      return (fabs(k1) < 1) && (fabs(k2) < 1);
+    }
+
+    /**
+     * Linear interpolation between two sections
+     * \param from Section at t = 0
+     * \param to Section at t = 1
+     * \param t Position between 0 and 1
+     **/
+    static LatticeSection interpolate(const LatticeSection& from, const LatticeSection& to, double t);
+  };
+
+  /**
+   * Converts all stages of a cascade to the lattice-ladder form
+   * \param cascade Coefficients of the cascade, for example from getCascadeStorage()
+   * \param sections Array of cascade.maxStages sections
+   * \return True if all stages are stable
+   **/
+  DllExport bool toLattice(const Cascade::Storage& cascade, LatticeSection* sections);
+
+  /**
+   * Writes lattice-ladder sections back into a cascade. Call
+   * updateStates() of the filter afterwards if its state is
+   * one which maps the coefficients (for example LatticeLadder).
+   * \param sections Array of cascade.maxStages sections
+   * \param cascade Coefficients of the cascade, for example from getCascadeStorage()
+   **/
+  DllExport void fromLattice(const LatticeSection* sections, const Cascade::Storage& cascade);
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * State for applying a second order section in the lattice-ladder form:
+   *
+   *  f1 = x - k2*g1[n-1]
+   *  f0 = f1 - k1*g0[n-1]
+   *  g2 = k2*f1 + g1[n-1]
+   *  g1 = k1*f0 + g0[n-1]
+   *  g0 = f0
+   *  y  = v0*g0 + v1*g1 + v2*g2
+   *
+   * The biquad is converted to the lattice coefficients whenever the
+   * filter is designed (see CascadeStages::updateStates()). For modulation
+   * the lattice coefficients can also be set directly with setSection()
+   * or passed to filter() at every sample.
+   **/
+  class DllExport LatticeLadder {
+  public:
+    LatticeLadder() {
+      reset();
+    }
+
+    void reset() {
+      m_g0 = 0;
+      m_g1 = 0;
+    }
+
+    /// largest absolute value in the delay lines
+    double getMaxAbsState() const {
+      return std::max(fabs(m_g0), fabs(m_g1));
+    }
+
+    /**
+     * Converts the coefficients of a biquad to the lattice form
+     * \param s The biquad
+     **/
+    void setCoefficients(const Biquad& s, const PoleZeroPair* = nullptr) {
+      m_lattice = LatticeSection(s);
+      m_mapped.set(s);
+    }
+
+    /// false if the biquad has changed since setCoefficients()
+    bool isMappedFrom(const Biquad& s) const {
+      return m_mapped.matches(s);
+    }
+
+    /**
+     * Sets the lattice coefficients directly, for example an
+     * interpolated section. The delay lines are kept.
+     **/
+    void setSection(const LatticeSection& section) {
+      m_lattice = section;
+      m_mapped.clear();
+    }
+
+    /// the current lattice coefficients
+    const LatticeSection& getSection() const {
+      return m_lattice;
+    }
+
+    inline double filter(const double in, const Biquad&) {
+      return filter(in, m_lattice);
+    }
+
+    /**
+     * Filters a sample with the given lattice coefficients instead of
+     * the ones which have been set
+     * \param in The sample
+     * \param section The lattice coefficients
+     **/
+    inline double filter(const double in, const LatticeSection& section) {
+      const double f1 = in - section.k2 * m_g1;
+      const double f0 = f1 - section.k1 * m_g0;
+      const double g2 = section.k2 * f1 + m_g1;
+      const double g1 = section.k1 * f0 + m_g0;
+      m_g1            = g1;
+      m_g0            = f0;
+
+      return section.v0 * f0 + section.v1 * g1 + section.v2 * g2;
+    }
+
+  private:
+    double m_g0 = 0;  // g0[n-1]
+    double m_g1 = 0;  // g1[n-1]
+
+    LatticeSection m_lattice;
+    MappedBiquad   m_mapped;
+  };
+
+  /**
+   * Runs a filter with LatticeLadder states with new lattice coefficients
+   * without converting them to biquads, for example sections which are
+   * interpolated at block rate. The biquads of the filter and so its
+   * response() are not changed. Use fromLattice() for this.
+   * \param filter The filter
+   * \param sections Array of one section per stage of the filter
+   **/
+  template<unsigned int MaxStages>
+  void setLattice(CascadeStages<MaxStages, LatticeLadder>& filter, const LatticeSection* sections) {
+    for (int i = 0; i < (int) MaxStages; i++)
+      filter.getState(i).setSection(sections[i]);
+  }
+
+}  // namespace Iir
+
+#endif
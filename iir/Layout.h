@@ -75,6 +75,15 @@ namespace Iir {
       m_pair     = other.m_pair;
     }
 
+    /**
+     * Points to another storage with a copy of the poles/zeros
+     * (for example after copying a filter) and keeps the number of poles.
+     **/
+    void rebindStorage(const LayoutBase& other) {
+      m_maxPoles = other.m_maxPoles;
+      m_pair     = other.m_pair;
+    }
+
     void reset() {
       m_numPoles = 0;
     }
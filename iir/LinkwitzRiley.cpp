@@ -0,0 +1,140 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "LinkwitzRiley.h"
+
+#include "Butterworth.h"
+#include "Common.h"
+
+namespace Iir { namespace LinkwitzRiley {
+
+  static const char crossoverIndexOutOfBounds[] = "Crossover index out of bounds.";
+
+  CrossoverBase::CrossoverBase()
+      : m_numCrossovers(0), m_maxCrossovers(0), m_numStages(0), m_lowPass(0), m_allPass(0),
+        m_frequencies(0) {}
+
+  void CrossoverBase::setCrossoverStorage(const Storage& storage) {
+    m_numCrossovers = 0;
+    m_maxCrossovers = storage.maxCrossovers;
+    m_numStages     = storage.numStages;
+    m_lowPass       = storage.lowPass;
+    m_allPass       = storage.allPass;
+    m_frequencies   = storage.frequencies;
+  }
+
+  void CrossoverBase::rebindCrossoverStorage(const Storage& storage) {
+    m_maxCrossovers = storage.maxCrossovers;
+    m_numStages     = storage.numStages;
+    m_lowPass       = storage.lowPass;
+    m_allPass       = storage.allPass;
+    m_frequencies   = storage.frequencies;
+  }
+
+  double CrossoverBase::getCrossoverFrequency(int index) const {
+    if ((index < 0) || (index >= m_numCrossovers))
+      throw std::invalid_argument(crossoverIndexOutOfBounds);
+    return m_frequencies[index];
+  }
+
+  void CrossoverBase::setup(int order, int numCrossovers, const double* frequencies) {
+    if ((order != 2) && (order != 4) && (order != 8))
+      throw std::invalid_argument("The Linkwitz-Riley order needs to be 2, 4 or 8.");
+    if ((numCrossovers < 1) || (numCrossovers > m_maxCrossovers))
+      throw std::invalid_argument(crossoverIndexOutOfBounds);
+    for (int c = 0; c < numCrossovers; c++) {
+      if ((frequencies[c] <= 0) || (frequencies[c] >= 0.5))
+        throw std::invalid_argument(
+            "The crossover frequencies need to be between 0 and the Nyquist frequency.");
+      if ((c > 0) && (frequencies[c] <= frequencies[c - 1]))
+        throw std::invalid_argument("The crossover frequencies need to be in ascending order.");
+    }
+
+    for (int c = 0; c < numCrossovers; c++) {
+      Butterworth::LowPass<4> prototype;
+      prototype.Butterworth::LowPassBase::setup(order / 2, frequencies[c]);
+      for (int s = 0; s < m_numStages; s++) {
+        Biquad& lp = m_lowPass[c * m_numStages + s];
+        Biquad& ap = m_allPass[c * m_numStages + s];
+        lp         = prototype[s];
+        // allpass with the same poles: the numerator is the reversed denominator
+        if (lp.m_a2 == 0)
+          ap.setCoefficients(1, lp.m_a1, 0, lp.m_a1, 1, 0);
+        else
+          ap.setCoefficients(1, lp.m_a1, lp.m_a2, lp.m_a2, lp.m_a1, 1);
+      }
+      m_frequencies[c] = frequencies[c];
+    }
+    m_numCrossovers = numCrossovers;
+  }
+
+  complex_t CrossoverBase::lowPassResponse(int crossover, complex_t czn1, complex_t czn2) const {
+    complex_t h(1);
+    for (int s = 0; s < m_numStages; s++) {
+      const Biquad& stage = m_lowPass[crossover * m_numStages + s];
+      h *= (stage.m_b0 + stage.m_b1 * czn1 + stage.m_b2 * czn2) /
+           (1. + stage.m_a1 * czn1 + stage.m_a2 * czn2);
+    }
+    return h * h;
+  }
+
+  complex_t CrossoverBase::allPassResponse(int crossover, complex_t czn1, complex_t czn2) const {
+    complex_t h(1);
+    for (int s = 0; s < m_numStages; s++) {
+      const Biquad& stage = m_allPass[crossover * m_numStages + s];
+      h *= (stage.m_b0 + stage.m_b1 * czn1 + stage.m_b2 * czn2) /
+           (1. + stage.m_a1 * czn1 + stage.m_a2 * czn2);
+    }
+    return h;
+  }
+
+  complex_t CrossoverBase::response(int band, double normalizedFrequency) const {
+    if ((band < 0) || (band > m_numCrossovers)) throw std::invalid_argument("Band index out of bounds.");
+
+    const double    w    = 2 * doublePi * normalizedFrequency;
+    const complex_t czn1 = std::polar(1., -w);
+    const complex_t czn2 = std::polar(1., -2 * w);
+
+    complex_t h(1);
+    if (band > 0)
+      h = allPassResponse(band - 1, czn1, czn2) - lowPassResponse(band - 1, czn1, czn2);
+    for (int c = band; c < m_numCrossovers; c++)
+      h *= lowPassResponse(c, czn1, czn2);
+    for (int c = 0; c < band - 1; c++)
+      h *= allPassResponse(c, czn1, czn2);
+    return h;
+  }
+
+}}  // namespace Iir::LinkwitzRiley
@@ -0,0 +1,325 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_LINKWITZRILEY_H
+#define IIR1_LINKWITZRILEY_H
+
+#include "Biquad.h"
+#include "Common.h"
+#include "MathSupplement.h"
+#include "State.h"
+
+#include <stdexcept>
+
+namespace Iir {
+
+  /**
+   * Linkwitz-Riley crossovers made of squared Butterworth filters.
+   * The lowpass of a crossover is the Butterworth lowpass applied
+   * twice and the highpass is the difference between the Butterworth
+   * allpass (same poles, mirrored zeros) and the lowpass. The bands
+   * then always sum up to an allpass.
+   **/
+  namespace LinkwitzRiley {
+
+    /**
+     * Factored implementation of the crossover which does not depend
+     * on the number of bands or the order. Designs the Butterworth
+     * lowpass and allpass sections of every crossover point.
+     **/
+    class DllExport CrossoverBase {
+    public:
+      /**
+       * Pointers to the coefficient arrays of the Crossover
+       **/
+      struct DllExport Storage {
+        /**
+         * \param maxCrossovers_ Number of crossover points the arrays can hold
+         * \param numStages_ Number of biquads of one Butterworth pass
+         * \param lowPass_ Array of the size [maxCrossovers_][numStages_]
+         * \param allPass_ Array of the size [maxCrossovers_][numStages_]
+         * \param frequencies_ Array of the size [maxCrossovers_]
+         **/
+        Storage(int maxCrossovers_, int numStages_, Biquad* const lowPass_,
+                Biquad* const allPass_, double* const frequencies_)
+            : maxCrossovers(maxCrossovers_), numStages(numStages_), lowPass(lowPass_),
+              allPass(allPass_), frequencies(frequencies_) {}
+
+        const int     maxCrossovers;
+        const int     numStages;
+        Biquad* const lowPass;
+        Biquad* const allPass;
+        double* const frequencies;
+      };
+
+      /**
+       * Returns the number of bands (crossover points + 1)
+       **/
+      int getNumBands() const {
+        return m_numCrossovers + 1;
+      }
+
+      /**
+       * Returns a normalised crossover frequency (0..1/2)
+       * \param index Index of the crossover point starting with the lowest one
+       **/
+      double getCrossoverFrequency(int index) const;
+
+      /**
+       * Calculates the response of one band (including its allpass
+       * compensation) at the given normalised frequency
+       * \param band Index of the band starting with the lowest one
+       * \param normalizedFrequency Frequency from 0 to 0.5 (Nyquist)
+       **/
+      complex_t response(int band, double normalizedFrequency) const;
+
+    protected:
+      CrossoverBase();
+
+      void setCrossoverStorage(const Storage& storage);
+
+      /**
+       * Points to arrays with a copy of the sections (for example after
+       * copying a crossover) and keeps the number of crossover points.
+       **/
+      void rebindCrossoverStorage(const Storage& storage);
+
+      /**
+       * Designs the sections of all crossover points
+       * \param order Linkwitz-Riley order: 2, 4 or 8
+       * \param numCrossovers Number of crossover points
+       * \param frequencies Normalised crossover frequencies in ascending order
+       **/
+      void setup(int order, int numCrossovers, const double* frequencies);
+
+    private:
+      complex_t lowPassResponse(int crossover, complex_t czn1, complex_t czn2) const;
+      complex_t allPassResponse(int crossover, complex_t czn1, complex_t czn2) const;
+
+      int     m_numCrossovers;
+      int     m_maxCrossovers;
+      int     m_numStages;
+      Biquad* m_lowPass;
+      Biquad* m_allPass;
+      double* m_frequencies;
+    };
+
+    //------------------------------------------------------------------------------
+
+    /**
+     * Linkwitz-Riley crossover which splits one input into NumBands bands
+     * in one pass. The input is split at the highest crossover point first
+     * and the lowpass output is split further down. The higher bands are then
+     * passed through the allpasses of the lower crossover points so that all
+     * bands have the same phase and sum up to an allpass.
+     * The first Butterworth stage of the lowpass and the allpass of a crossover
+     * share their recursion because they have the same poles.
+     * \param NumBands Number of bands (2 for a 2-way crossover)
+     * \param Order Linkwitz-Riley order: 2 (LR2), 4 (LR4) or 8 (LR8)
+     **/
+    template<unsigned int NumBands = 2, unsigned int Order = 4>
+    class DllExport Crossover : public CrossoverBase {
+      static_assert(NumBands >= 2, "A crossover needs at least two bands.");
+      static_assert((Order == 2) || (Order == 4) || (Order == 8),
+                    "The Linkwitz-Riley order needs to be 2, 4 or 8.");
+
+      static const int NumCrossovers = NumBands - 1;
+      static const int NumStages     = (Order / 2 + 1) / 2;
+
+    public:
+      Crossover() {
+        CrossoverBase::setCrossoverStorage(
+            Storage(NumCrossovers, NumStages, &m_lowPass[0][0], &m_allPass[0][0], m_frequencies));
+        reset();
+      }
+
+      Crossover(const Crossover& other) : CrossoverBase(other) {
+        copyArrays(other);
+      }
+
+      Crossover& operator=(const Crossover& other) {
+        CrossoverBase::operator=(other);
+        copyArrays(other);
+        return *this;
+      }
+
+      /**
+       * Sets up a 2-way crossover
+       * \param sampleRate Sampling rate
+       * \param crossoverFrequency Crossover frequency
+       **/
+      void setup(double sampleRate, double crossoverFrequency) {
+        setupN(crossoverFrequency / sampleRate);
+      }
+
+      /**
+       * Sets up a 2-way crossover
+       * \param crossoverFrequency Normalised crossover frequency (0..1/2)
+       **/
+      void setupN(double crossoverFrequency) {
+        static_assert(NumBands == 2, "Provide an array of NumBands-1 crossover frequencies.");
+        CrossoverBase::setup(Order, NumCrossovers, &crossoverFrequency);
+        reset();
+      }
+
+      /**
+       * Sets up the crossover
+       * \param sampleRate Sampling rate
+       * \param crossoverFrequencies NumBands-1 crossover frequencies in ascending order
+       **/
+      void setup(double sampleRate, const double (&crossoverFrequencies)[NumBands - 1]) {
+        double frequencies[NumCrossovers];
+        for (int i = 0; i < NumCrossovers; i++)
+          frequencies[i] = crossoverFrequencies[i] / sampleRate;
+        CrossoverBase::setup(Order, NumCrossovers, frequencies);
+        reset();
+      }
+
+      /**
+       * Sets up the crossover
+       * \param crossoverFrequencies NumBands-1 normalised crossover frequencies (0..1/2)
+       * in ascending order
+       **/
+      void setupN(const double (&crossoverFrequencies)[NumBands - 1]) {
+        CrossoverBase::setup(Order, NumCrossovers, crossoverFrequencies);
+        reset();
+      }
+
+      /**
+       * Resets all delay lines but not the coefficients
+       **/
+      void reset() {
+        for (int c = 0; c < NumCrossovers; c++) {
+          m_shared[c][0] = 0;
+          m_shared[c][1] = 0;
+          for (int s = 0; s < NumStages; s++) {
+            m_lowPassStates[c][0][s].reset();
+            m_lowPassStates[c][1][s].reset();
+            m_allPassStates[c][s].reset();
+          }
+        }
+        for (auto& band : m_compensationStates)
+          for (auto& crossover : band)
+            for (auto& state : crossover)
+              state.reset();
+      }
+
+      /**
+       * Filters one sample into all bands
+       * \param in Sample to be filtered
+       * \param bandOutputs Array of NumBands outputs starting with the lowest band
+       **/
+      template<typename Sample>
+      inline void filter(const Sample in, Sample* bandOutputs) {
+        double rest = in;
+        for (int c = NumCrossovers - 1; c >= 0; c--) {
+          double high;
+          split(c, rest, rest, high);
+          // the band above crossover c needs the allpasses of the crossovers below
+          for (int i = 0; i < c; i++)
+            for (int s = 0; s < NumStages; s++)
+              high = m_compensationStates[c + 1][i][s].filter(high, m_allPass[i][s]);
+          bandOutputs[c + 1] = static_cast<Sample>(high);
+        }
+        bandOutputs[0] = static_cast<Sample>(rest);
+      }
+
+      /**
+       * Filters a block of samples into all bands
+       * \param in Input samples
+       * \param n Number of samples
+       * \param bandOutputs NumBands output arrays of the length n starting with the lowest band
+       **/
+      template<typename Sample>
+      void filter(const Sample* in, int n, Sample* const* bandOutputs) {
+        Sample out[NumBands];
+        for (int i = 0; i < n; i++) {
+          filter(in[i], out);
+          for (int b = 0; b < (int) NumBands; b++)
+            bandOutputs[b][i] = out[b];
+        }
+      }
+
+    private:
+      inline void split(int c, double in, double& low, double& high) {
+        const Biquad& lp0 = m_lowPass[c][0];
+        const Biquad& ap0 = m_allPass[c][0];
+        double* const v   = m_shared[c];
+
+        // first stage: lowpass and allpass have the same poles
+        const double w  = in - lp0.m_a1 * v[0] - lp0.m_a2 * v[1];
+        double       lp = lp0.m_b0 * w + lp0.m_b1 * v[0] + lp0.m_b2 * v[1];
+        double       ap = ap0.m_b0 * w + ap0.m_b1 * v[0] + ap0.m_b2 * v[1];
+        v[1]            = v[0];
+        v[0]            = w;
+
+        for (int s = 1; s < NumStages; s++) {
+          lp = m_lowPassStates[c][0][s].filter(lp, m_lowPass[c][s]);
+          ap = m_allPassStates[c][s].filter(ap, m_allPass[c][s]);
+        }
+        // second Butterworth pass
+        for (int s = 0; s < NumStages; s++)
+          lp = m_lowPassStates[c][1][s].filter(lp, m_lowPass[c][s]);
+
+        low  = lp;
+        high = ap - lp;
+      }
+
+      void copyArrays(const Crossover& other) {
+        std::memcpy(m_lowPass, other.m_lowPass, sizeof(m_lowPass));
+        std::memcpy(m_allPass, other.m_allPass, sizeof(m_allPass));
+        std::memcpy(m_frequencies, other.m_frequencies, sizeof(m_frequencies));
+        std::memcpy(m_shared, other.m_shared, sizeof(m_shared));
+        std::memcpy(m_lowPassStates, other.m_lowPassStates, sizeof(m_lowPassStates));
+        std::memcpy(m_allPassStates, other.m_allPassStates, sizeof(m_allPassStates));
+        std::memcpy(m_compensationStates, other.m_compensationStates, sizeof(m_compensationStates));
+        CrossoverBase::rebindCrossoverStorage(
+            Storage(NumCrossovers, NumStages, &m_lowPass[0][0], &m_allPass[0][0], m_frequencies));
+      }
+
+      Biquad       m_lowPass[NumCrossovers][NumStages];
+      Biquad       m_allPass[NumCrossovers][NumStages];
+      double       m_frequencies[NumCrossovers];
+      double       m_shared[NumCrossovers][2];
+      DirectFormII m_lowPassStates[NumCrossovers][2][NumStages];
+      DirectFormII m_allPassStates[NumCrossovers][NumStages];
+      DirectFormII m_compensationStates[NumBands][NumCrossovers][NumStages];
+    };
+
+  }  // namespace LinkwitzRiley
+
+}  // namespace Iir
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_PCM_H
+#define IIR1_PCM_H
+
+#include "Common.h"
+
+#include <stdexcept>
+#include <stdint.h>
+
+namespace Iir {
+
+  /**
+   * Converts integer PCM samples to double and back. The input is
+   * scaled from its full scale to +/-1 and the output from +/-1 to its
+   * full scale, rounded to the nearest integer and saturated. Optionally
+   * triangular (TPDF) dither of +/-1 LSB is added before rounding.
+   * 24 bit samples are kept in int32_t (right aligned).
+   **/
+  class DllExport PCMConverter {
+  public:
+    /**
+     * \param inputBits Bits of the input samples (2..32)
+     * \param outputBits Bits of the output samples (2..32)
+     * \param dither Adds TPDF dither before the rounding of the output
+     **/
+    PCMConverter(int inputBits = 16, int outputBits = 16, bool dither = false) {
+      setup(inputBits, outputBits, dither);
+    }
+
+    /**
+     * Sets the input and output formats
+     * \param inputBits Bits of the input samples (2..32)
+     * \param outputBits Bits of the output samples (2..32)
+     * \param dither Adds TPDF dither before the rounding of the output
+     **/
+    void setup(int inputBits, int outputBits, bool dither = false) {
+      if ((inputBits < 2) || (inputBits > 32) || (outputBits < 2) || (outputBits > 32))
+        throw std::invalid_argument("The number of bits needs to be between 2 and 32.");
+      m_inputScale  = 1 / ldexp(1., inputBits - 1);
+      m_outputScale = ldexp(1., outputBits - 1);
+      m_max         = m_outputScale - 1;
+      m_min         = -m_outputScale;
+      m_dither      = dither;
+    }
+
+    /**
+     * Sets an additional gain which is applied to the input samples
+     **/
+    void setInputGain(double gain) {
+      m_inputGain = gain;
+    }
+
+    /**
+     * Converts an input sample to double (full scale is +/-1)
+     **/
+    template<typename PCMSample>
+    inline double toDouble(const PCMSample in) const {
+      return static_cast<double>(in) * m_inputScale * m_inputGain;
+    }
+
+    /**
+     * Converts a double (full scale is +/-1) to an output sample
+     * with rounding, saturation and optional dither
+     **/
+    template<typename PCMSample>
+    inline PCMSample toPCM(const double in) {
+      double v = in * m_outputScale;
+      if (m_dither) v += (random() + random()) * (1. / 4294967296.) - 1;
+      if (v > m_max) v = m_max;
+      if (v < m_min) v = m_min;
+      return static_cast<PCMSample>(lrint(v));
+    }
+
+    /**
+     * Resets the random generator of the dither
+     **/
+    void reset(uint32_t seed = 1) {
+      m_seed = seed;
+    }
+
+  private:
+    // linear congruential generator (Numerical Recipes)
+    inline double random() {
+      m_seed = m_seed * 1664525u + 1013904223u;
+      return static_cast<double>(m_seed);
+    }
+
+    double   m_inputScale  = 1;
+    double   m_inputGain   = 1;
+    double   m_outputScale = 1;
+    double   m_max         = 0;
+    double   m_min         = 0;
+    bool     m_dither      = false;
+    uint32_t m_seed        = 1;
+  };
+
+  /**
+   * Filters a block of integer PCM samples. The conversion to and from
+   * double happens sample by sample inside of the filter loop so that
+   * the buffers are only read and written once.
+   * \param filter Any filter with a filter(double) method
+   * \param in Input samples
+   * \param n Number of samples
+   * \param out Output samples, can be the same as the input (in-place)
+   * \param converter Formats, gain and dither of the conversion
+   * \param inStride Distance between two input samples
+   * \param outStride Distance between two output samples
+   **/
+  template<class Filter, typename InSample, typename OutSample>
+  void filterPCM(Filter& filter, const InSample* in, int n, OutSample* out, PCMConverter& converter,
+                 int inStride = 1, int outStride = 1) {
+    for (int i = 0; i < n; i++) {
+      *out = converter.template toPCM<OutSample>(filter.filter(converter.toDouble(*in)));
+      in += inStride;
+      out += outStride;
+    }
+  }
+
+}  // namespace Iir
+
+#endif
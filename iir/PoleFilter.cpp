@@ -55,14 +55,20 @@ namespace Iir {
   }
 
   LowPassTransform::LowPassTransform(double fc, LayoutBase& digital, LayoutBase const& analog) {
+    setup(fc);
+    apply(digital, analog);
+  }
 
+  void LowPassTransform::setup(double fc) {
     if (!(fc < 0.5)) throw std::invalid_argument(cutoffError);
     if (fc < 0.0) throw std::invalid_argument(cutoffNeg);
 
-    digital.reset();
-
     // prewarp
     f = tan(doublePi * fc);
+  }
+
+  void LowPassTransform::apply(LayoutBase& digital, LayoutBase const& analog) {
+    digital.reset();
 
     const int numPoles = analog.getNumPoles();
     const int pairs    = numPoles / 2;
@@ -79,6 +85,33 @@ namespace Iir {
     digital.setNormal(analog.getNormalW(), analog.getNormalGain());
   }
 
+  void LowPassTransform::apply(Biquad* stages, LayoutBase const& analog) const {
+    const int numPoles = analog.getNumPoles();
+    const int pairs    = numPoles / 2;
+    for (int i = 0; i < pairs; ++i) {
+      const PoleZeroPair& pair = analog[i];
+      double              a1, a2, b1, b2;
+      transformPair(pair.poles.first, a1, a2);
+      transformPair(pair.zeros.first, b1, b2);
+      stages[i].setCoefficients(1, a1, a2, 1, b1, b2);
+    }
+
+    if (numPoles & 1) {
+      const double p = f * analog[pairs].poles.first.real();
+      const double z = f * analog[pairs].zeros.first.real();
+      stages[pairs].setOnePole((1 + p) / (1 - p), (1 + z) / (1 - z));
+    }
+  }
+
+  // z^2 + c1 * z + c2 with the transformed conjugate pair of c
+  void LowPassTransform::transformPair(complex_t c, double& c1, double& c2) const {
+    const double re   = f * c.real();
+    const double norm = f * f * std::norm(c);
+    const double d    = 1 / (1 - 2 * re + norm);
+    c1                = -2 * (1 - norm) * d;
+    c2                = (1 + 2 * re + norm) * d;
+  }
+
   //------------------------------------------------------------------------------
 
   complex_t HighPassTransform::transform(complex_t c) {
@@ -92,13 +125,20 @@ namespace Iir {
   }
 
   HighPassTransform::HighPassTransform(double fc, LayoutBase& digital, LayoutBase const& analog) {
+    setup(fc);
+    apply(digital, analog);
+  }
+
+  void HighPassTransform::setup(double fc) {
     if (!(fc < 0.5)) throw std::invalid_argument(cutoffError);
     if (fc < 0.0) throw std::invalid_argument(cutoffNeg);
 
-    digital.reset();
-
     // prewarp
     f = 1. / tan(doublePi * fc);
+  }
+
+  void HighPassTransform::apply(LayoutBase& digital, LayoutBase const& analog) {
+    digital.reset();
 
     const int numPoles = analog.getNumPoles();
     const int pairs    = numPoles / 2;
@@ -115,15 +155,49 @@ namespace Iir {
     digital.setNormal(doublePi - analog.getNormalW(), analog.getNormalGain());
   }
 
+  void HighPassTransform::apply(Biquad* stages, LayoutBase const& analog) const {
+    const int numPoles = analog.getNumPoles();
+    const int pairs    = numPoles / 2;
+    for (int i = 0; i < pairs; ++i) {
+      const PoleZeroPair& pair = analog[i];
+      double              a1, a2, b1, b2;
+      transformPair(pair.poles.first, a1, a2);
+      transformPair(pair.zeros.first, b1, b2);
+      stages[i].setCoefficients(1, a1, a2, 1, b1, b2);
+    }
+
+    if (numPoles & 1) {
+      const double p = f * analog[pairs].poles.first.real();
+      const double z = f * analog[pairs].zeros.first.real();
+      stages[pairs].setOnePole(-(1 + p) / (1 - p), -(1 + z) / (1 - z));
+    }
+  }
+
+  // z^2 + c1 * z + c2 with the transformed conjugate pair of c
+  void HighPassTransform::transformPair(complex_t c, double& c1, double& c2) const {
+    const double re   = f * c.real();
+    const double norm = f * f * std::norm(c);
+    const double d    = 1 / (1 - 2 * re + norm);
+    c1                = 2 * (1 - norm) * d;
+    c2                = (1 + 2 * re + norm) * d;
+  }
+
   //------------------------------------------------------------------------------
 
   BandPassTransform::BandPassTransform(
       double fc, double fw, LayoutBase& digital, LayoutBase const& analog) {
+    setup(fc, fw);
+    apply(digital, analog);
+  }
+
+  BandPassTransform::BandPassTransform()
+      : wc(0), wc2(0), a(0), b(0), a2(0), b2(0), ab(0), ab_2(0), analogNormalW(-1),
+        digitalNormalW(0) {}
+
+  void BandPassTransform::setup(double fc, double fw) {
     if (!(fc < 0.5)) throw std::invalid_argument(cutoffError);
     if (fc < 0.0) throw std::invalid_argument(cutoffNeg);
 
-    digital.reset();
-
     const double ww = 2 * doublePi * fw;
 
     // pre-calcs
@@ -141,6 +215,13 @@ namespace Iir {
     ab   = a * b;
     ab_2 = 2 * ab;
 
+    // the normal frequency needs to be calculated again
+    analogNormalW = -1;
+  }
+
+  void BandPassTransform::apply(LayoutBase& digital, LayoutBase const& analog) {
+    digital.reset();
+
     const int numPoles = analog.getNumPoles();
     const int pairs    = numPoles / 2;
     for (int i = 0; i < pairs; ++i) {
@@ -159,12 +240,67 @@ namespace Iir {
       digital.add(poles, zeros);
     }
 
-    double wn = analog.getNormalW();
-    digital.setNormal(
-        2 * atan(sqrt(tan((wc + wn) * 0.5) * tan((wc2 + wn) * 0.5))), analog.getNormalGain());
+    const double wn = analog.getNormalW();
+    if (wn != analogNormalW) {
+      analogNormalW  = wn;
+      digitalNormalW = 2 * atan(sqrt(tan((wc + wn) * 0.5) * tan((wc2 + wn) * 0.5)));
+    }
+    digital.setNormal(digitalNormalW, analog.getNormalGain());
+  }
+
+  void BandPassTransform::apply(Biquad* stages, LayoutBase const& analog) const {
+    const int numPoles = analog.getNumPoles();
+    const int pairs    = numPoles / 2;
+    for (int i = 0; i < pairs; ++i) {
+      const PoleZeroPair& pair = analog[i];
+      double              a1[2], a2[2], b1[2], b2[2];
+      transformPair(pair.poles.first, a1, a2);
+      transformPair(pair.zeros.first, b1, b2);
+      stages[2 * i].setCoefficients(1, a1[0], a2[0], 1, b1[0], b2[0]);
+      stages[2 * i + 1].setCoefficients(1, a1[1], a2[1], 1, b1[1], b2[1]);
+    }
+
+    if (numPoles & 1) {
+      const ComplexPair poles = transform(analog[pairs].poles.first);
+      const ComplexPair zeros = transform(analog[pairs].zeros.first);
+      stages[2 * pairs].setTwoPole(poles.first, zeros.first, poles.second, zeros.second);
+    }
+  }
+
+  // z^2 + c1[k] * z + c2[k] with the conjugate pairs of both transformed roots of c,
+  // as in transform() but with real divisions
+  void BandPassTransform::transformPair(complex_t c, double* c1, double* c2) const {
+    // bilinear
+    const double norm = std::norm(c);
+    c = complex_t(1 - norm, 2 * c.imag()) * (1 / (1 - 2 * c.real() + norm));
+
+    const double k = b2 * (a2 - 1);
+    complex_t    v = 4 * (k + 1) * c;
+    v += 8 * (k - 1);
+    v *= c;
+    v += 4 * (k + 1);
+
+    // principal square root with real square roots
+    const double r = sqrt((std::abs(v.real()) + sqrt(std::norm(v))) / 2);
+    if (r != 0) {
+      if (v.real() >= 0)
+        v = complex_t(r, v.imag() / (2 * r));
+      else
+        v = complex_t(std::abs(v.imag()) / (2 * r), std::signbit(v.imag()) ? -r : r);
+    }
+
+    const complex_t q = ab_2 * (c + 1.);
+    const complex_t d = 2 * (b - 1) * c + 2 * (1 + b);
+
+    const double    dd       = 1 / std::norm(d);
+    const complex_t roots[2] = {q - v, q + v};
+    for (int i = 0; i < 2; ++i) {
+      c1[i] = -2 * (roots[i] * std::conj(d)).real() * dd;
+      c2[i] = std::norm(roots[i]) * dd;
+    }
   }
 
-  ComplexPair BandPassTransform::transform(complex_t c) {
+  ComplexPair BandPassTransform::transform(complex_t c) const {
     if (c == infinity()) return ComplexPair(-1, 1);
 
     c = (1. + c) / (1. - c);  // bilinear
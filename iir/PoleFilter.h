@@ -65,8 +65,12 @@ namespace Iir {
     // It can also be used to accelerate the interpolation
     // of pole/zeros for parameter modulation, since a pole
     // filter already has them calculated
+    //
+    // After a fast gain update of a shelf there is no digital
+    // prototype and they are recovered from the biquads.
 
     std::vector<PoleZeroPair> getPoleZeros() const {
+      if (m_digitalProto.getNumPoles() == 0) return Cascade::getPoleZeros();
       std::vector<PoleZeroPair> vpz;
       const int                 pairs = (m_digitalProto.getNumPoles() + 1) / 2;
       for (int i = 0; i < pairs; ++i)
@@ -90,6 +94,11 @@ namespace Iir {
       m_digitalProto = digitalStorage;
     }
 
+    void rebindPrototypeStorage(const LayoutBase& analogStorage, const LayoutBase& digitalStorage) {
+      m_analogProto.rebindStorage(analogStorage);
+      m_digitalProto.rebindStorage(digitalStorage);
+    }
+
   protected:
     AnalogPrototype m_analogProto;
   };
@@ -114,6 +123,41 @@ namespace Iir {
       BaseClass::setPrototypeStorage(m_analogStorage, m_digitalStorage);
     }
 
+    /**
+     * Copies the filter (coefficients and delay lines). The factored base
+     * classes are then pointed at the storage of the copy.
+     **/
+    PoleFilter(const PoleFilter& other)
+        : BaseClass(other)
+        , CascadeStages<(MaxDigitalPoles + 1) / 2, StateType>(other)
+        , m_analogStorage(other.m_analogStorage)
+        , m_digitalStorage(other.m_digitalStorage) {
+      BaseClass::rebindCascadeStorage(this->getCascadeStorage());
+      BaseClass::rebindPrototypeStorage(m_analogStorage, m_digitalStorage);
+    }
+
+    PoleFilter& operator=(const PoleFilter& other) {
+      BaseClass::operator=(other);
+      CascadeStages<(MaxDigitalPoles + 1) / 2, StateType>::operator=(other);
+      m_analogStorage  = other.m_analogStorage;
+      m_digitalStorage = other.m_digitalStorage;
+      BaseClass::rebindCascadeStorage(this->getCascadeStorage());
+      BaseClass::rebindPrototypeStorage(m_analogStorage, m_digitalStorage);
+      return *this;
+    }
+
+  protected:
+    /**
+     * Passes the new biquads to the states which run them in another
+     * form. The designs call this after every setup() and setGain(),
+     * with the digital poles and zeros unless a fast gain update has
+     * left only the coefficients.
+     **/
+    void stagesChanged() {
+      const LayoutBase& digital = BaseClass::m_digitalProto;
+      this->updateStates((digital.getNumPoles() > 0) ? &digital : nullptr);
+    }
+
   private:
     Layout<MaxAnalogPoles>  m_analogStorage;
     Layout<MaxDigitalPoles> m_digitalStorage;
@@ -139,9 +183,35 @@ namespace Iir {
   public:
     LowPassTransform(double fc, LayoutBase& digital, LayoutBase const& analog);
 
+    LowPassTransform() : f(0) {}
+
+    /**
+     * Calculates the frequency dependent constants
+     * \param fc Normalised cutoff frequency
+     **/
+    void setup(double fc);
+
+    /**
+     * Transforms an analog prototype with the constants of setup()
+     **/
+    void apply(LayoutBase& digital, LayoutBase const& analog);
+
+    /**
+     * Transforms an analog prototype with the constants of setup()
+     * straight into the biquads without a digital layout, with real
+     * numbers where possible. This is for fast updates of filters whose
+     * poles and zeros are all finite (the shelves). The biquads still
+     * need to be normalised.
+     * \param stages One biquad per pole/zero pair of the digital layout
+     * \param analog Analog prototype
+     **/
+    void apply(Biquad* stages, LayoutBase const& analog) const;
+
   private:
     complex_t transform(complex_t c);
 
+    void transformPair(complex_t c, double& c1, double& c2) const;
+
     double f;
   };
 
@@ -154,9 +224,35 @@ namespace Iir {
   public:
     HighPassTransform(double fc, LayoutBase& digital, LayoutBase const& analog);
 
+    HighPassTransform() : f(0) {}
+
+    /**
+     * Calculates the frequency dependent constants
+     * \param fc Normalised cutoff frequency
+     **/
+    void setup(double fc);
+
+    /**
+     * Transforms an analog prototype with the constants of setup()
+     **/
+    void apply(LayoutBase& digital, LayoutBase const& analog);
+
+    /**
+     * Transforms an analog prototype with the constants of setup()
+     * straight into the biquads without a digital layout, with real
+     * numbers where possible. This is for fast updates of filters whose
+     * poles and zeros are all finite (the shelves). The biquads still
+     * need to be normalised.
+     * \param stages One biquad per pole/zero pair of the digital layout
+     * \param analog Analog prototype
+     **/
+    void apply(Biquad* stages, LayoutBase const& analog) const;
+
   private:
     complex_t transform(complex_t c);
 
+    void transformPair(complex_t c, double& c1, double& c2) const;
+
     double f;
   };
 
@@ -170,8 +266,35 @@ namespace Iir {
   public:
     BandPassTransform(double fc, double fw, LayoutBase& digital, LayoutBase const& analog);
 
+    BandPassTransform();
+
+    /**
+     * Calculates the frequency dependent constants
+     * \param fc Normalised centre frequency
+     * \param fw Normalised width of the band
+     **/
+    void setup(double fc, double fw);
+
+    /**
+     * Transforms an analog prototype with the constants of setup()
+     **/
+    void apply(LayoutBase& digital, LayoutBase const& analog);
+
+    /**
+     * Transforms an analog prototype with the constants of setup()
+     * straight into the biquads without a digital layout, with real
+     * numbers where possible. This is for fast updates of filters whose
+     * poles and zeros are all finite (the shelves). The biquads still
+     * need to be normalised.
+     * \param stages One biquad per pole/zero pair of the digital layout
+     * \param analog Analog prototype
+     **/
+    void apply(Biquad* stages, LayoutBase const& analog) const;
+
   private:
-    ComplexPair transform(complex_t c);
+    ComplexPair transform(complex_t c) const;
+
+    void transformPair(complex_t c, double* c1, double* c2) const;
 
     double wc;
     double wc2;
@@ -181,6 +304,9 @@ namespace Iir {
     double b2;
     double ab;
     double ab_2;
+    // digital normal frequency of the last analog normal frequency
+    double analogNormalW;
+    double digitalNormalW;
   };
 
   //------------------------------------------------------------------------------
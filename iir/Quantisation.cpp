@@ -0,0 +1,128 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#include "Quantisation.h"
+
+#include "Common.h"
+
+#include <algorithm>
+
+namespace Iir {
+
+  Precision Precision::fixedPoint(int fractionalBits, int integerBits) {
+    if ((fractionalBits < 1) || (integerBits < 1) || ((fractionalBits + integerBits) > 64))
+      throw std::invalid_argument("Invalid fixed point format.");
+    return Precision(fractionalBits, integerBits);
+  }
+
+  double Precision::quantise(double value, bool& overflow) const {
+    if (!isFixedPoint()) return static_cast<float>(value);
+
+    const double scale = ldexp(1., m_fractionalBits);
+    const double max   = ldexp(1., m_integerBits - 1);
+    double       q     = std::round(value * scale) / scale;
+    if (q >= max) {
+      q        = max - 1 / scale;
+      overflow = true;
+    }
+    if (q < -max) {
+      q        = -max;
+      overflow = true;
+    }
+    return q;
+  }
+
+  // largest magnitude of the roots of z^2 + a1*z + a2
+  static double poleRadius(double a1, double a2) {
+    const complex_t d = std::sqrt(complex_t(a1 * a1 - 4 * a2));
+    return std::max(std::abs((-a1 + d) / 2.), std::abs((-a1 - d) / 2.));
+  }
+
+  QuantisationReport analyseQuantisation(
+      const Cascade::Storage& cascade, const Precision& precision, int gridSize) {
+    if (gridSize < 2) throw std::invalid_argument("The grid needs at least two frequencies.");
+
+    QuantisationReport report;
+    const int          numStages = cascade.maxStages;
+    std::vector<Biquad> quantised(cascade.stageArray, cascade.stageArray + numStages);
+
+    for (auto& stage : quantised) {
+      const double r = poleRadius(stage.m_a1, stage.m_a2);
+      stage.m_b0     = precision.quantise(stage.m_b0, report.overflow);
+      stage.m_b1     = precision.quantise(stage.m_b1, report.overflow);
+      stage.m_b2     = precision.quantise(stage.m_b2, report.overflow);
+      stage.m_a1     = precision.quantise(stage.m_a1, report.overflow);
+      stage.m_a2     = precision.quantise(stage.m_a2, report.overflow);
+      const double rq = poleRadius(stage.m_a1, stage.m_a2);
+      report.maxPoleRadiusShift = std::max(report.maxPoleRadiusShift, fabs(rq - r));
+      report.maxPoleRadius      = std::max(report.maxPoleRadius, rq);
+    }
+    report.stable = report.maxPoleRadius < 1;
+
+    // responses of both cascades on the same grid
+    std::vector<double> h(gridSize);
+    std::vector<double> hq(gridSize);
+    double              peak = 0;
+    for (int g = 0; g < gridSize; g++) {
+      const double    w    = doublePi * g / (gridSize - 1);
+      const complex_t czn1 = std::polar(1., -w);
+      const complex_t czn2 = std::polar(1., -2 * w);
+      complex_t       c(1);
+      complex_t       cq(1);
+      for (int i = 0; i < numStages; i++) {
+        const Biquad& s = cascade.stageArray[i];
+        const Biquad& q = quantised[i];
+        c *= (s.m_b0 + s.m_b1 * czn1 + s.m_b2 * czn2) / (1. + s.m_a1 * czn1 + s.m_a2 * czn2);
+        cq *= (q.m_b0 + q.m_b1 * czn1 + q.m_b2 * czn2) / (1. + q.m_a1 * czn1 + q.m_a2 * czn2);
+      }
+      h[g]  = std::abs(c);
+      hq[g] = std::abs(cq);
+      peak  = std::max(peak, h[g]);
+    }
+
+    const double floor = peak * 1E-3;
+    for (int g = 0; g < gridSize; g++) {
+      report.maxMagnitudeDeviation = std::max(report.maxMagnitudeDeviation, fabs(hq[g] - h[g]));
+      if (h[g] < floor) continue;
+      // a quantised filter which has lost its gain is infinitely off
+      const double db = (hq[g] > 0) ? fabs(20 * log10(hq[g] / h[g]))
+                                    : std::numeric_limits<double>::infinity();
+      report.maxMagnitudeDeviationDb = std::max(report.maxMagnitudeDeviationDb, db);
+    }
+
+    return report;
+  }
+
+}  // namespace Iir
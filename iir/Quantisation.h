@@ -0,0 +1,121 @@
+/**
+ *
+ * "A Collection of Useful C++ Classes for Digital Signal Processing"
+ * By Vinnie Falco and Bernd Porr
+ *
+ * Official project location:
+ * https://github.com/berndporr/iir1
+ *
+ * See Documentation.cpp for contact information, notes, and bibliography.
+ *
+ * -----------------------------------------------------------------
+ *
+ * License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+ * Copyright (c) 2009 by Vinnie Falco
+ * Copyright (c) 2011-2021 by Bernd Porr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ **/
+
+#ifndef IIR1_QUANTISATION_H
+#define IIR1_QUANTISATION_H
+
+#include "Biquad.h"
+#include "Cascade.h"
+#include "Common.h"
+
+namespace Iir {
+
+  /**
+   * Number format of the coefficients of a reduced-precision kernel
+   **/
+  class DllExport Precision {
+  public:
+    /**
+     * IEEE single precision (float)
+     **/
+    static Precision singleFloat() {
+      return Precision(0, 0);
+    }
+
+    /**
+     * Fixed point Qm.n format with the sign bit included in the integer bits.
+     * For example fixedPoint(30, 2) for Q31 coefficients in the range -2..2.
+     * \param fractionalBits Number of bits after the binary point
+     * \param integerBits Number of bits before the binary point including the sign
+     **/
+    static Precision fixedPoint(int fractionalBits, int integerBits = 2);
+
+    /**
+     * Returns true if this is a fixed point format
+     **/
+    bool isFixedPoint() const {
+      return m_fractionalBits > 0;
+    }
+
+    /**
+     * Quantises a coefficient. Fixed point values outside of the range
+     * are saturated.
+     * \param value Coefficient
+     * \param overflow Set to true if the value has been saturated
+     **/
+    double quantise(double value, bool& overflow) const;
+
+  private:
+    Precision(int fractionalBits, int integerBits)
+        : m_fractionalBits(fractionalBits), m_integerBits(integerBits) {}
+
+    int m_fractionalBits;
+    int m_integerBits;
+  };
+
+  /**
+   * Result of the quantisation analysis of a cascade
+   **/
+  struct DllExport QuantisationReport {
+    /// largest change of the radius of a pole
+    double maxPoleRadiusShift = 0;
+    /// largest pole radius after quantisation
+    double maxPoleRadius = 0;
+    /// largest deviation of the magnitude of the response
+    double maxMagnitudeDeviation = 0;
+    /// largest deviation in dB where the response is within 60dB of its peak,
+    /// infinite if the quantised response vanishes there
+    double maxMagnitudeDeviationDb = 0;
+    /// all poles are inside of the unit circle after quantisation
+    bool stable = true;
+    /// a fixed point coefficient has been saturated
+    bool overflow = false;
+  };
+
+  /**
+   * Quantises the coefficients of a designed cascade to the given precision
+   * and reports how much the poles move and the response changes, and whether
+   * the quantised filter is still stable. The coefficients themselves are not
+   * changed. The responses are evaluated on a grid from DC to Nyquist.
+   * \param cascade Coefficients of the cascade, for example from getCascadeStorage()
+   * \param precision Target precision
+   * \param gridSize Number of frequencies between DC and Nyquist
+   **/
+  DllExport QuantisationReport analyseQuantisation(
+      const Cascade::Storage& cascade, const Precision& precision, int gridSize = 1024);
+
+}  // namespace Iir
+
+#endif
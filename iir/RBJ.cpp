@@ -123,11 +123,19 @@ namespace Iir { namespace RBJ {
   }
 
   void LowShelf::setupN(double cutoffFrequency, double gainDb, double shelfSlope) {
+    double w0    = 2 * doublePi * cutoffFrequency;
+    m_cs         = cos(w0);
+    m_sn         = sin(w0);
+    m_shelfSlope = shelfSlope;
+    m_hasSetup   = true;
+    setGain(gainDb);
+  }
+
+  void LowShelf::setGain(double gainDb) {
+    if (!m_hasSetup) throw std::invalid_argument(gainBeforeSetup);
     double A  = pow(10, gainDb / 40);
-    double w0 = 2 * doublePi * cutoffFrequency;
-    double cs = cos(w0);
-    double sn = sin(w0);
-    double AL = sn / 2 * ::std::sqrt((A + 1 / A) * (1 / shelfSlope - 1) + 2);
+    double cs = m_cs;
+    double AL = m_sn / 2 * ::std::sqrt((A + 1 / A) * (1 / m_shelfSlope - 1) + 2);
     double sq = 2 * sqrt(A) * AL;
     double b0 = A * ((A + 1) - (A - 1) * cs + sq);
     double b1 = 2 * A * ((A - 1) - (A + 1) * cs);
@@ -139,11 +147,19 @@ namespace Iir { namespace RBJ {
   }
 
   void HighShelf::setupN(double cutoffFrequency, double gainDb, double shelfSlope) {
+    double w0    = 2 * doublePi * cutoffFrequency;
+    m_cs         = cos(w0);
+    m_sn         = sin(w0);
+    m_shelfSlope = shelfSlope;
+    m_hasSetup   = true;
+    setGain(gainDb);
+  }
+
+  void HighShelf::setGain(double gainDb) {
+    if (!m_hasSetup) throw std::invalid_argument(gainBeforeSetup);
     double A  = pow(10, gainDb / 40);
-    double w0 = 2 * doublePi * cutoffFrequency;
-    double cs = cos(w0);
-    double sn = sin(w0);
-    double AL = sn / 2 * ::std::sqrt((A + 1 / A) * (1 / shelfSlope - 1) + 2);
+    double cs = m_cs;
+    double AL = m_sn / 2 * ::std::sqrt((A + 1 / A) * (1 / m_shelfSlope - 1) + 2);
     double sq = 2 * sqrt(A) * AL;
     double b0 = A * ((A + 1) + (A - 1) * cs + sq);
     double b1 = -2 * A * ((A - 1) + (A + 1) * cs);
@@ -155,18 +171,26 @@ namespace Iir { namespace RBJ {
   }
 
   void BandShelf::setupN(double centerFrequency, double gainDb, double bandWidth) {
-    double A  = pow(10, gainDb / 40);
     double w0 = 2 * doublePi * centerFrequency;
-    double cs = cos(w0);
     double sn = sin(w0);
     double AL = sn * sinh(doubleLn2 / 2 * bandWidth * w0 / sn);
     if (Iir::is_nan(AL))
       throw std::invalid_argument("No solution available for these parameters.\n");
+    m_cs       = cos(w0);
+    m_alpha    = AL;
+    m_hasSetup = true;
+    setGain(gainDb);
+  }
+
+  void BandShelf::setGain(double gainDb) {
+    if (!m_hasSetup) throw std::invalid_argument(gainBeforeSetup);
+    double A  = pow(10, gainDb / 40);
+    double AL = m_alpha;
     double b0 = 1 + AL * A;
-    double b1 = -2 * cs;
+    double b1 = -2 * m_cs;
     double b2 = 1 - AL * A;
     double a0 = 1 + AL / A;
-    double a1 = -2 * cs;
+    double a1 = -2 * m_cs;
     double a2 = 1 - AL / A;
     setCoefficients(a0, a1, a2, b0, b1, b2);
   }
@@ -37,6 +37,7 @@
 #define IIR1_RBJ_H
 
 #include "Biquad.h"
+#include "Block.h"
 #include "Common.h"
 #include "State.h"
 
@@ -70,6 +71,39 @@ namespace Iir {
       inline Sample filter(Sample s) {
         return static_cast<Sample>(state.filter(static_cast<double>(s), *this));
       }
+      /// filters a (strided) block of samples, can be in-place
+      template<typename Sample>
+      void filter(const Sample* in, int n, Sample* out, int inStride = 1, int outStride = 1) {
+        for (int i = 0; i < n; i++) {
+          *out = filter(*in);
+          in += inStride;
+          out += outStride;
+        }
+      }
+      /// filters a (strided) block and calculates the statistics of the output
+      template<typename Sample>
+      void filter(const Sample* in, int n, Sample* out, BlockStatistics& stats, int inStride = 1,
+                  int outStride = 1) {
+        stats.reset();
+        for (int i = 0; i < n; i++) {
+          const Sample y = filter(*in);
+          *out           = y;
+          stats.add(static_cast<double>(y));
+          in += inStride;
+          out += outStride;
+        }
+      }
+      /// filters a (strided) block with input gain / offset and dry/wet mix
+      template<typename Sample>
+      void filter(const Sample* in, int n, Sample* out, const BlockMix& mix, int inStride = 1,
+                  int outStride = 1) {
+        for (int i = 0; i < n; i++) {
+          const double u = mix.transform(static_cast<double>(*in));
+          *out           = static_cast<Sample>(mix.mix(u, filter(u)));
+          in += inStride;
+          out += outStride;
+        }
+      }
       /// resets the delay lines to zero
       void reset() {
         state.reset();
@@ -240,6 +274,19 @@ namespace Iir {
       void setup(double sampleRate, double cutoffFrequency, double gainDb, double shelfSlope = 1) {
         setupN(cutoffFrequency / sampleRate, gainDb, shelfSlope);
       }
+
+      /**
+       * Changes only the gain. The frequency dependent terms of the
+       * last setup() are kept so that no trigonometric function is evaluated.
+       * \param gainDb Gain in the passband
+       **/
+      void setGain(double gainDb);
+
+    private:
+      double m_cs         = 1;
+      double m_sn         = 0;
+      double m_shelfSlope = 1;
+      bool   m_hasSetup   = false;
     };
 
     /**
@@ -263,6 +310,17 @@ namespace Iir {
       void setup(double sampleRate, double cutoffFrequency, double gainDb, double shelfSlope = 1) {
         setupN(cutoffFrequency / sampleRate, gainDb, shelfSlope);
       }
+
+      /**
+       * Changes only the gain (see LowShelf::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      double m_cs         = 1;
+      double m_sn         = 0;
+      double m_shelfSlope = 1;
+      bool   m_hasSetup   = false;
     };
 
     /**
@@ -286,6 +344,16 @@ namespace Iir {
       void setup(double sampleRate, double centerFrequency, double gainDb, double bandWidth) {
         setupN(centerFrequency / sampleRate, gainDb, bandWidth);
       }
+
+      /**
+       * Changes only the gain (see LowShelf::setGain())
+       **/
+      void setGain(double gainDb);
+
+    private:
+      double m_cs       = 1;
+      double m_alpha    = 0;
+      bool   m_hasSetup = false;
     };
 
     /**
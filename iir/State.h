@@ -39,6 +39,10 @@
 #include "Biquad.h"
 #include "Common.h"
 
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
 #include <stdexcept>
 
 #define DEFAULT_STATE DirectFormII
@@ -66,6 +70,11 @@ namespace Iir {
       m_y2 = 0;
     }
 
+    /// largest absolute value in the delay lines
+    double getMaxAbsState() const {
+      return std::max(std::max(fabs(m_x1), fabs(m_x2)), std::max(fabs(m_y1), fabs(m_y2)));
+    }
+
     inline double filter(const double in, const Biquad& s) {
       const double out =
           s.m_b0 * in + s.m_b1 * m_x1 + s.m_b2 * m_x2 - s.m_a1 * m_y1 - s.m_a2 * m_y2;
@@ -77,6 +86,14 @@ namespace Iir {
       return out;
     }
 
+    /**
+     * Advances the state by one sample when the output is not needed.
+     * The recursion needs the output so this is the same as filter().
+     **/
+    inline void advance(const double in, const Biquad& s) {
+      filter(in, s);
+    }
+
   protected:
     double m_x2 = 0;  // x[n-2]
     double m_y2 = 0;  // y[n-2]
@@ -106,6 +123,11 @@ namespace Iir {
       m_v2 = 0;
     }
 
+    /// largest absolute value in the delay lines
+    double getMaxAbsState() const {
+      return std::max(fabs(m_v1), fabs(m_v2));
+    }
+
     inline double filter(const double in, const Biquad& s) {
       const double w   = in - s.m_a1 * m_v1 - s.m_a2 * m_v2;
       const double out = s.m_b0 * w + s.m_b1 * m_v1 + s.m_b2 * m_v2;
@@ -116,6 +138,17 @@ namespace Iir {
       return out;
     }
 
+    /**
+     * Advances the state by one sample without evaluating
+     * the output (FIR) part of the difference equation.
+     **/
+    inline void advance(const double in, const Biquad& s) {
+      const double w = in - s.m_a1 * m_v1 - s.m_a2 * m_v2;
+
+      m_v2 = m_v1;
+      m_v1 = w;
+    }
+
   private:
     double m_v1 = 0;  // v[-1]
     double m_v2 = 0;  // v[-2]
@@ -136,6 +169,11 @@ namespace Iir {
       m_s2_1 = 0;
     }
 
+    /// largest absolute value in the delay lines
+    double getMaxAbsState() const {
+      return std::max(fabs(m_s1), fabs(m_s2));
+    }
+
     inline double filter(const double in, const Biquad& s) {
       const double out = m_s1_1 + s.m_b0 * in;
       m_s1             = m_s2_1 + s.m_b1 * in - s.m_a1 * out;
@@ -146,6 +184,14 @@ namespace Iir {
       return out;
     }
 
+    /**
+     * Advances the state by one sample when the output is not needed.
+     * The recursion needs the output so this is the same as filter().
+     **/
+    inline void advance(const double in, const Biquad& s) {
+      filter(in, s);
+    }
+
   private:
     double m_s1   = 0;
     double m_s1_1 = 0;
@@ -153,6 +199,491 @@ namespace Iir {
     double m_s2_1 = 0;
   };
 
+  //------------------------------------------------------------------------------
+
+  /**
+   * Complex valued (I/Q) version of DirectFormI. The coefficients are real
+   * and shared between the real and imaginary parts which are kept
+   * interleaved in the delay lines so that they are processed together.
+   **/
+  class DllExport ComplexDirectFormI {
+  public:
+    ComplexDirectFormI() {
+      reset();
+    }
+
+    void reset() {
+      m_x1 = 0;
+      m_x2 = 0;
+      m_y1 = 0;
+      m_y2 = 0;
+    }
+
+    /// largest magnitude in the delay lines
+    double getMaxAbsState() const {
+      return std::max(std::max(std::abs(m_x1), std::abs(m_x2)), std::max(std::abs(m_y1), std::abs(m_y2)));
+    }
+
+    inline complex_t filter(const complex_t in, const Biquad& s) {
+      const complex_t out =
+          s.m_b0 * in + s.m_b1 * m_x1 + s.m_b2 * m_x2 - s.m_a1 * m_y1 - s.m_a2 * m_y2;
+      m_x2 = m_x1;
+      m_y2 = m_y1;
+      m_x1 = in;
+      m_y1 = out;
+
+      return out;
+    }
+
+  protected:
+    complex_t m_x2 = 0;  // x[n-2]
+    complex_t m_y2 = 0;  // y[n-2]
+    complex_t m_x1 = 0;  // x[n-1]
+    complex_t m_y1 = 0;  // y[n-1]
+  };
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Complex valued (I/Q) version of DirectFormII
+   **/
+  class DllExport ComplexDirectFormII {
+  public:
+    ComplexDirectFormII() {
+      reset();
+    }
+
+    void reset() {
+      m_v1 = 0;
+      m_v2 = 0;
+    }
+
+    /// largest magnitude in the delay lines
+    double getMaxAbsState() const {
+      return std::max(std::abs(m_v1), std::abs(m_v2));
+    }
+
+    inline complex_t filter(const complex_t in, const Biquad& s) {
+      const complex_t w   = in - s.m_a1 * m_v1 - s.m_a2 * m_v2;
+      const complex_t out = s.m_b0 * w + s.m_b1 * m_v1 + s.m_b2 * m_v2;
+
+      m_v2 = m_v1;
+      m_v1 = w;
+
+      return out;
+    }
+
+  private:
+    complex_t m_v1 = 0;  // v[-1]
+    complex_t m_v2 = 0;  // v[-2]
+  };
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Complex valued (I/Q) version of TransposedDirectFormII
+   **/
+  class DllExport ComplexTransposedDirectFormII {
+  public:
+    ComplexTransposedDirectFormII() {
+      reset();
+    }
+
+    void reset() {
+      m_s1 = 0;
+      m_s2 = 0;
+    }
+
+    /// largest magnitude in the delay lines
+    double getMaxAbsState() const {
+      return std::max(std::abs(m_s1), std::abs(m_s2));
+    }
+
+    inline complex_t filter(const complex_t in, const Biquad& s) {
+      const complex_t out = m_s1 + s.m_b0 * in;
+      m_s1                = m_s2 + s.m_b1 * in - s.m_a1 * out;
+      m_s2                = s.m_b2 * in - s.m_a2 * out;
+
+      return out;
+    }
+
+  private:
+    complex_t m_s1 = 0;
+    complex_t m_s2 = 0;
+  };
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Fingerprint of the biquad which a state has mapped to coefficients
+   * of its own. CascadeStages compares it in debug builds with the biquad
+   * it filters with to catch biquads which have been changed through
+   * getCascadeStorage() without calling updateStates() afterwards.
+   **/
+  class DllExport MappedBiquad {
+  public:
+    /// remembers the biquad which has been mapped
+    void set(const Biquad& s) {
+      m_fingerprint = fingerprint(s);
+    }
+
+    /// the coefficients have been set directly and are not checked
+    void clear() {
+      m_fingerprint = 0;
+    }
+
+    /// false if s is not the biquad which has been mapped
+    bool matches(const Biquad& s) const {
+      return (m_fingerprint == 0) || (m_fingerprint == fingerprint(s));
+    }
+
+  private:
+    static uint64_t fingerprint(const Biquad& s) {
+      const double c[5] = {s.m_a1, s.m_a2, s.m_b0, s.m_b1, s.m_b2};
+      uint64_t     h    = 14695981039346656037ULL;
+      for (const double v : c) {
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        h = (h ^ bits) * 1099511628211ULL;
+      }
+      return (h != 0) ? h : 1;
+    }
+
+    uint64_t m_fingerprint = 0;
+  };
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * State for applying a second order section as a trapezoidal (Cytomic
+   * style) state variable filter. The two integrator states stay well
+   * scaled even at very low cutoff frequencies where the delay lines of
+   * the direct forms nearly cancel. The biquad is mapped to the SVF gains
+   * g, k and the output mix m0, m1, m2:
+   *
+   *  v3 = x - ic2
+   *  v1 = (ic1 + g*v3) / (1 + g*(g + k))
+   *  v2 = ic2 + g*v1
+   *  ic1 = 2*v1 - ic1, ic2 = 2*v2 - ic2
+   *  y  = m0*x + m1*v1 + m2*v2
+   *
+   * The mapping is done in double precision whenever the filter is designed
+   * (see CascadeStages::updateStates()). g is calculated from the distance
+   * of the poles to z = 1 and not from a1 and a2 which have lost most of
+   * their relative precision there. This keeps the cutoff precise even if
+   * the states and gains are only floats.
+   * \param Real Precision of the states and gains: float or double
+   **/
+  template<typename Real = double>
+  class DllExport StateVariableFormT {
+  public:
+    StateVariableFormT() {
+      reset();
+    }
+
+    void reset() {
+      m_ic1 = 0;
+      m_ic2 = 0;
+    }
+
+    /// largest absolute value in the integrators
+    double getMaxAbsState() const {
+      return std::max(fabs((double) m_ic1), fabs((double) m_ic2));
+    }
+
+    /**
+     * Maps the coefficients of a biquad to the SVF
+     * \param s The biquad
+     * \param pair The poles and zeros of the biquad or null if unknown
+     **/
+    void setCoefficients(const Biquad& s, const PoleZeroPair* pair = nullptr) {
+      // denominator at z = 1 and z = -1 and 1 - a2
+      double dp, dm, da;
+      if (pair != nullptr) {
+        const complex_t p1 = pair->poles.first;
+        const complex_t p2 = pair->poles.second;
+        dp                 = ((1. - p1) * (1. - p2)).real();
+        dm                 = ((1. + p1) * (1. + p2)).real();
+        da                 = 1 - (p1 * p2).real();
+      } else {
+        dp = 1 + s.m_a1 + s.m_a2;
+        dm = 1 - s.m_a1 + s.m_a2;
+        da = 1 - s.m_a2;
+      }
+      if (!(dp > 0) || !(dm > 0))
+        throw std::invalid_argument("The state variable form needs poles inside of the unit circle.");
+
+      const double g2 = dp / dm;
+      const double g  = sqrt(g2);
+      const double c1 = 1 / (1 + 2 * da / dm + g2);
+      const double m0 = (s.m_b0 - s.m_b1 + s.m_b2) / dm;
+
+      m_c1 = static_cast<Real>(c1);
+      m_c2 = static_cast<Real>(g * c1);
+      m_c3 = static_cast<Real>(g2 * c1);
+      m_m0 = static_cast<Real>(m0);
+      m_m1 = static_cast<Real>(2 * ((s.m_b0 - s.m_b2) - m0 * da) / (dm * g));
+      m_m2 = static_cast<Real>((s.m_b0 + s.m_b1 + s.m_b2) / dp - m0);
+      m_mapped.set(s);
+    }
+
+    /// false if the biquad has changed since setCoefficients()
+    bool isMappedFrom(const Biquad& s) const {
+      return m_mapped.matches(s);
+    }
+
+    inline double filter(const double in, const Biquad&) {
+      const Real x  = static_cast<Real>(in);
+      const Real v3 = x - m_ic2;
+      const Real v1 = m_c1 * m_ic1 + m_c2 * v3;
+      const Real v2 = m_ic2 + m_c2 * m_ic1 + m_c3 * v3;
+      m_ic1         = 2 * v1 - m_ic1;
+      m_ic2         = 2 * v2 - m_ic2;
+
+      return m_m0 * x + m_m1 * v1 + m_m2 * v2;
+    }
+
+  private:
+    Real m_ic1 = 0;  // integrator states
+    Real m_ic2 = 0;
+
+    Real m_c1 = 1;  // 1 / (1 + g*(g + k)), g*c1, g*c2
+    Real m_c2 = 0;
+    Real m_c3 = 0;
+    Real m_m0 = 1;  // output mix
+    Real m_m1 = 0;
+    Real m_m2 = 0;
+
+    MappedBiquad m_mapped;
+  };
+
+  /// State variable form in double precision
+  typedef StateVariableFormT<double> StateVariableForm;
+
+  /// State variable form with float states and gains
+  typedef StateVariableFormT<float> StateVariableFormFloat;
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * State for applying a second order section in the coupled (Gold-Rader)
+   * form. For the complex poles alpha +/- j*beta the states rotate with
+   *
+   *  s1[n+1] = alpha*s1[n] - beta*s2[n] + x[n]
+   *  s2[n+1] = beta*s1[n] + alpha*s2[n]
+   *  y[n]    = b0*x[n] + c1*s1[n] + c2*s2[n]
+   *
+   * so that the poles are quantised on a uniform grid which is much finer
+   * close to z = 1 than with the direct forms. alpha and beta are taken
+   * from the poles of the design when they are known. Sections with real
+   * poles fall back to DirectFormII. The mapping is done whenever the
+   * filter is designed (see CascadeStages::updateStates()).
+   * \param Real Precision of the states and coefficients: float or double
+   **/
+  template<typename Real = double>
+  class DllExport CoupledFormT {
+  public:
+    CoupledFormT() {
+      reset();
+    }
+
+    void reset() {
+      m_s1 = 0;
+      m_s2 = 0;
+    }
+
+    /// largest absolute value in the states
+    double getMaxAbsState() const {
+      return std::max(fabs((double) m_s1), fabs((double) m_s2));
+    }
+
+    /**
+     * Maps the coefficients of a biquad to the coupled form
+     * \param s The biquad
+     * \param pair The poles and zeros of the biquad or null if unknown
+     **/
+    void setCoefficients(const Biquad& s, const PoleZeroPair* pair = nullptr) {
+      double alpha = -s.m_a1 / 2;
+      double beta  = 0;
+      bool   real  = true;
+      if (pair != nullptr) {
+        real = (pair->poles.first.imag() == 0);
+        if (!real) {
+          alpha = pair->poles.first.real();
+          beta  = fabs(pair->poles.first.imag());
+        }
+      } else {
+        const double bb = s.m_a2 - alpha * alpha;
+        real            = !(bb > 0);
+        if (!real) beta = sqrt(bb);
+      }
+
+      if (real) {
+        m_a1 = static_cast<Real>(s.m_a1);
+        m_a2 = static_cast<Real>(s.m_a2);
+        m_b0 = static_cast<Real>(s.m_b0);
+        m_b1 = static_cast<Real>(s.m_b1);
+        m_b2 = static_cast<Real>(s.m_b2);
+      } else {
+        const double a2 = alpha * alpha + beta * beta;
+        const double c1 = s.m_b1 + 2 * alpha * s.m_b0;
+        m_alpha         = static_cast<Real>(alpha);
+        m_beta          = static_cast<Real>(beta);
+        m_b0            = static_cast<Real>(s.m_b0);
+        m_c1            = static_cast<Real>(c1);
+        m_c2            = static_cast<Real>(((s.m_b2 - s.m_b0 * a2) + c1 * alpha) / beta);
+      }
+      // the meaning of the states changes
+      if (real != m_real) reset();
+      m_real = real;
+      m_mapped.set(s);
+    }
+
+    /// false if the biquad has changed since setCoefficients()
+    bool isMappedFrom(const Biquad& s) const {
+      return m_mapped.matches(s);
+    }
+
+    inline double filter(const double in, const Biquad&) {
+      const Real x = static_cast<Real>(in);
+      if (m_real) {
+        const Real w   = x - m_a1 * m_s1 - m_a2 * m_s2;
+        const Real out = m_b0 * w + m_b1 * m_s1 + m_b2 * m_s2;
+        m_s2           = m_s1;
+        m_s1           = w;
+        return out;
+      }
+
+      const Real out = m_b0 * x + m_c1 * m_s1 + m_c2 * m_s2;
+      const Real s1  = m_alpha * m_s1 - m_beta * m_s2 + x;
+      m_s2           = m_beta * m_s1 + m_alpha * m_s2;
+      m_s1           = s1;
+
+      return out;
+    }
+
+  private:
+    Real m_s1 = 0;
+    Real m_s2 = 0;
+
+    bool m_real  = true;  // real poles: DirectFormII
+    Real m_alpha = 0;
+    Real m_beta  = 0;
+    Real m_c1    = 0;
+    Real m_c2    = 0;
+
+    Real m_a1 = 0;  // DirectFormII coefficients for real poles
+    Real m_a2 = 0;
+    Real m_b0 = 1;
+    Real m_b1 = 0;
+    Real m_b2 = 0;
+
+    MappedBiquad m_mapped;
+  };
+
+  /// Coupled form in double precision
+  typedef CoupledFormT<double> CoupledForm;
+
+  /// Coupled form with float states and coefficients
+  typedef CoupledFormT<float> CoupledFormFloat;
+
+  //------------------------------------------------------------------------------
+
+  /**
+   * Wrapper around any of the states above which records the peak and
+   * the RMS of the output of its biquad and the largest value in its
+   * delay lines. Used as the StateType of a filter it shows the dynamic
+   * range of every stage of a cascade (see CascadeStages::getState()).
+   * With Recording = false the wrapper is the plain state without any
+   * extra members or code and all statistics are zero, so that a project
+   * can switch the profiling off with one constant of its own.
+   * \param StateType The state which is wrapped
+   * \param Recording Records the statistics
+   **/
+  template<class StateType, bool Recording>
+  class DllExport ProfiledState : public StateType {
+  public:
+    template<typename Sample>
+    inline Sample filter(const Sample in, const Biquad& s) {
+      const Sample out = StateType::filter(in, s);
+      const double a   = std::abs(out);
+      if (a > m_peak) m_peak = a;
+      m_sumOfSquares += a * a;
+      const double state = StateType::getMaxAbsState();
+      if (state > m_maxState) m_maxState = state;
+      m_numSamples++;
+      return out;
+    }
+
+    /**
+     * The output of a stage which is skipped while decimating is
+     * still calculated so that it is recorded.
+     **/
+    inline void advance(const double in, const Biquad& s) {
+      filter(in, s);
+    }
+
+    /// clears the recorded statistics but not the delay lines
+    void resetProfile() {
+      m_peak         = 0;
+      m_sumOfSquares = 0;
+      m_maxState     = 0;
+      m_numSamples   = 0;
+    }
+
+    /// largest absolute output value
+    double getPeak() const {
+      return m_peak;
+    }
+
+    /// root mean square of the output
+    double getRMS() const {
+      if (m_numSamples == 0) return 0;
+      return sqrt(m_sumOfSquares / (double) m_numSamples);
+    }
+
+    /// largest absolute value in the delay lines
+    double getMaxState() const {
+      return m_maxState;
+    }
+
+    /// number of recorded samples
+    long getNumSamples() const {
+      return m_numSamples;
+    }
+
+  private:
+    double m_peak         = 0;
+    double m_sumOfSquares = 0;
+    double m_maxState     = 0;
+    long   m_numSamples   = 0;
+  };
+
+  /**
+   * ProfiledState without recording: the plain state
+   **/
+  template<class StateType>
+  class DllExport ProfiledState<StateType, false> : public StateType {
+  public:
+    void resetProfile() {}
+
+    double getPeak() const {
+      return 0;
+    }
+
+    double getRMS() const {
+      return 0;
+    }
+
+    double getMaxState() const {
+      return 0;
+    }
+
+    long getNumSamples() const {
+      return 0;
+    }
+  };
+
 }  // namespace Iir
 
 #endif
@@ -118,6 +118,14 @@ namespace Iir {
     kindOther
   };
 
+  /**
+   * Norm used to scale the stages of a cascade (see Cascade::optimiseStages)
+   **/
+  enum ScalingNorm {
+    normL2,   // energy of the impulse response (Parseval)
+    normLinf  // peak of the magnitude response
+  };
+
 }  // namespace Iir
 
 #endif
@@ -0,0 +1,169 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+int main(int, char**)
+{
+	const int order = 6;
+	const int stages = order / 2;
+	Iir::ChebyshevI::LowPass<order, Iir::ProfiledState<Iir::DirectFormI, true> > f;
+	f.setup(1000, 10, 1);
+
+	// reference: the stages of the cascade one by one
+	Iir::DirectFormI ref[stages];
+	double peak[stages] = {};
+	double sum[stages] = {};
+	double maxState[stages] = {};
+
+	const int n = 10000;
+	for (int i = 0; i < n; i++) {
+		const double x = sin(2 * M_PI * 9.0 * i / 1000);
+		double y = x;
+		for (int s = 0; s < stages; s++) {
+			y = ref[s].filter(y, f.getCascadeStorage().stageArray[s]);
+			if (fabs(y) > peak[s]) peak[s] = fabs(y);
+			sum[s] += y * y;
+			if (ref[s].getMaxAbsState() > maxState[s]) maxState[s] = ref[s].getMaxAbsState();
+		}
+		const double b = f.filter(x);
+		assert_print(b == y, "The profiled filter differs from the plain one.\n");
+	}
+
+	for (int s = 0; s < stages; s++) {
+		const Iir::ProfiledState<Iir::DirectFormI, true>& p = f.getState(s);
+		fprintf(stderr, "Stage %d: peak = %f, rms = %f, max state = %f\n",
+			s, p.getPeak(), p.getRMS(), p.getMaxState());
+		assert_print(p.getNumSamples() == n, "Wrong number of samples.\n");
+		assert_print(p.getPeak() == peak[s], "Wrong stage peak.\n");
+		assert_print(fabs(p.getRMS() - sqrt(sum[s] / n)) < 1E-12, "Wrong stage RMS.\n");
+		assert_print(p.getMaxState() == maxState[s], "Wrong stage state maximum.\n");
+	}
+
+	// without recording the wrapper is the plain state and records nothing
+	Iir::ChebyshevI::LowPass<order, Iir::ProfiledState<Iir::DirectFormI, false> > fOff;
+	Iir::ChebyshevI::LowPass<order, Iir::DirectFormI> fPlain;
+	fOff.setup(1000, 10, 1);
+	assert_print(sizeof(fOff) == sizeof(fPlain), "The wrapper without recording is not the plain state.\n");
+	for (int i = 0; i < 100; i++) fOff.filter(sin(0.1 * i));
+	assert_print(fOff.getState(0).getNumSamples() == 0, "Recorded without recording.\n");
+	assert_print(fOff.getState(0).getPeak() == 0, "Recorded a peak without recording.\n");
+
+	// the last stage is recorded while decimating although its output is discarded
+	Iir::ChebyshevI::LowPass<order, Iir::ProfiledState<Iir::DirectFormII, true> > fDec;
+	Iir::ChebyshevI::LowPass<order, Iir::ProfiledState<Iir::DirectFormII, true> > fFull;
+	fDec.setup(1000, 10, 1);
+	fFull.setup(1000, 10, 1);
+	double xd[400];
+	double yd[100];
+	for (int i = 0; i < 400; i++) {
+		xd[i] = sin(0.05 * i);
+		fFull.filter(xd[i]);
+	}
+	fDec.filterDecimate(xd, 400, 4, yd);
+	assert_print(fDec.getState(stages - 1).getNumSamples() == 400, "Decimated stage not recorded.\n");
+	assert_print(fDec.getState(stages - 1).getPeak() == fFull.getState(stages - 1).getPeak(),
+		"Wrong peak of the decimated stage.\n");
+
+	// the 9Hz signal is in the passband so the last stage has unity gain
+	assert_print(fabs(f.getState(stages - 1).getPeak() - 1) < 0.15, "Wrong peak of the last stage.\n");
+
+	// reordering and scaling of the stages keeps the response
+	Iir::ChebyshevI::BandStop<8> bs;
+	Iir::ChebyshevI::BandStop<8> bsRef;
+	bs.setup(1000, 100, 20, 0.5);
+	bsRef.setup(1000, 100, 20, 0.5);
+	const Iir::ScalingNorm norms[] = { Iir::normL2, Iir::normLinf };
+	for (Iir::ScalingNorm norm : norms) {
+		bs.optimise(norm);
+		for (double fr = 0.001; fr < 0.5; fr += 0.001) {
+			const double h = abs(bs.response(fr));
+			const double hRef = abs(bsRef.response(fr));
+			assert_print(fabs(h - hRef) < 1E-9 * (1 + hRef), "Optimised response differs.\n");
+		}
+		// increasing pole radius
+		const Iir::Biquad* s = bs.getCascadeStorage().stageArray;
+		double radius = 0;
+		for (int i = 0; i < bs.getNumStages(); i++) {
+			const double r = sqrt(fabs(s[i].m_a2));
+			assert_print(r >= radius - 1E-12, "Stages not ordered by pole radius.\n");
+			radius = r;
+		}
+		// the peak of the cumulative response of all but the last stage is one
+		if (norm == Iir::normLinf) {
+			for (int k = 0; k < bs.getNumStages() - 1; k++) {
+				double peakGain = 0;
+				for (double fr = 0; fr <= 0.5; fr += 0.0001) {
+					const double w = 2 * M_PI * fr;
+					Iir::complex_t h = 1;
+					for (int i = 0; i <= k; i++) {
+						const Iir::complex_t z1 = std::polar(1., -w);
+						const Iir::complex_t z2 = std::polar(1., -2 * w);
+						h *= (s[i].m_b0 + s[i].m_b1 * z1 + s[i].m_b2 * z2) /
+							(1. + s[i].m_a1 * z1 + s[i].m_a2 * z2);
+					}
+					if (abs(h) > peakGain) peakGain = abs(h);
+				}
+				fprintf(stderr, "Peak gain after stage %d: %f\n", k, peakGain);
+				assert_print(fabs(peakGain - 1) < 0.05, "Stage not scaled to unity peak gain.\n");
+			}
+		}
+		// same output as the original filter
+		bsRef.reset();
+		for (int i = 0; i < 10000; i++) {
+			const double x = sin(0.05 * i) + cos(0.7 * i);
+			const double b = bs.filter(x);
+			const double bRef = bsRef.filter(x);
+			assert_print(fabs(b - bRef) < 1E-9, "Optimised filter output differs.\n");
+		}
+	}
+
+	// quantisation of the coefficients
+	Iir::Butterworth::LowPass<4> lp;
+	lp.setup(48000, 1000);
+	Iir::QuantisationReport r = Iir::analyseQuantisation(lp.getCascadeStorage(), Iir::Precision::singleFloat());
+	fprintf(stderr, "float: radius shift = %e, deviation = %e dB\n", r.maxPoleRadiusShift, r.maxMagnitudeDeviationDb);
+	assert_print(r.stable, "Float lowpass not stable.\n");
+	assert_print(!r.overflow, "Float overflow.\n");
+	assert_print(r.maxPoleRadiusShift < 1E-6, "Float pole shift too large.\n");
+	assert_print(r.maxMagnitudeDeviationDb < 0.01, "Float deviation too large.\n");
+
+	// 0.1Hz highpass at 1kHz in Q15 is not usable
+	Iir::Butterworth::HighPass<2> hp;
+	hp.setup(1000, 0.1);
+	r = Iir::analyseQuantisation(hp.getCascadeStorage(), Iir::Precision::fixedPoint(14, 2));
+	fprintf(stderr, "Q15: radius = %f, radius shift = %e, deviation = %e\n",
+		r.maxPoleRadius, r.maxPoleRadiusShift, r.maxMagnitudeDeviation);
+	assert_print(!r.stable || (r.maxMagnitudeDeviation > 0.1), "Q15 highpass should be unusable.\n");
+
+	// but in Q31 it is fine
+	r = Iir::analyseQuantisation(hp.getCascadeStorage(), Iir::Precision::fixedPoint(30, 2));
+	fprintf(stderr, "Q31: radius = %f, radius shift = %e, deviation = %e dB\n",
+		r.maxPoleRadius, r.maxPoleRadiusShift, r.maxMagnitudeDeviationDb);
+	assert_print(r.stable, "Q31 highpass not stable.\n");
+	assert_print(r.maxMagnitudeDeviationDb < 0.1, "Q31 deviation too large.\n");
+
+	// a lowpass whose numerator rounds to zero in Q15 has lost its gain
+	Iir::Butterworth::LowPass<2> dead;
+	dead.setup(1000, 1);
+	r = Iir::analyseQuantisation(dead.getCascadeStorage(), Iir::Precision::fixedPoint(14, 2));
+	fprintf(stderr, "Q15 1Hz lowpass: stable = %d, deviation = %e dB\n", r.stable, r.maxMagnitudeDeviationDb);
+	assert_print(isinf(r.maxMagnitudeDeviationDb), "Dead filter not reported.\n");
+	assert_print(!(r.stable && (r.maxMagnitudeDeviationDb < 0.1)), "Dead filter accepted.\n");
+
+	// coefficients which don't fit into Q1.15 are saturated
+	r = Iir::analyseQuantisation(lp.getCascadeStorage(), Iir::Precision::fixedPoint(15, 1));
+	assert_print(r.overflow, "No overflow reported.\n");
+
+	try {
+		f.getState(stages);
+		assert_print(0, "No exception thrown for a stage out of bounds.");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr, "Correct exception thrown: %s\n", e.what());
+	}
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+#include <type_traits>
+#include <vector>
+
+#include "assert_print.h"
+
+const int n = 4096;
+
+// runs the filter directly and via the handle and compares the results
+template<class Filter>
+void compare(Filter& f, Iir::AnyFilter& any, const char* name) {
+	std::vector<double> x(n), y(n), yAny(n);
+	for (int i = 0; i < n; i++) {
+		x[i] = sin(0.01 * i) + 0.3 * sin(0.4 * i) + ((i % 500) == 0 ? 1 : 0);
+	}
+	f.reset();
+	any.reset();
+	f.filter(x.data(), n, y.data());
+	any.filter(x.data(), n, yAny.data());
+	for (int i = 0; i < n; i++) {
+		assert_print(y[i] == yAny[i], "The handle filters differently.\n");
+	}
+	fprintf(stderr, "%s: %s\n", name, any.isOnHeap() ? "heap" : "buffer");
+}
+
+int main(int, char**)
+{
+	// copies of pole filters need to run on their own coefficients
+	Iir::Butterworth::LowPass<8> lp;
+	lp.setup(1000, 50);
+	Iir::Butterworth::LowPass<8> lpCopy(lp);
+	lp.setup(1000, 200);
+	assert_print(fabs(std::abs(lpCopy.response(50.0 / 1000)) - sqrt(0.5)) < 1E-10,
+		     "Copy of a PoleFilter shares the coefficients of the original.\n");
+	Iir::Butterworth::LowPass<8> lpAssigned;
+	lpAssigned = lpCopy;
+	lpCopy.setup(1000, 300);
+	assert_print(fabs(std::abs(lpAssigned.response(50.0 / 1000)) - sqrt(0.5)) < 1E-10,
+		     "Assigned PoleFilter shares the coefficients of the original.\n");
+	assert_print(lpAssigned.getNumStages() == 4, "Number of stages lost when copying.\n");
+
+	// the same for filters with their own factored storage
+	Iir::LinkwitzRiley::Crossover<3> crossover;
+	const double crossoverFrequencies[2] = {100, 300};
+	const double otherFrequencies[2] = {50, 200};
+	crossover.setup(1000, crossoverFrequencies);
+	Iir::LinkwitzRiley::Crossover<3> crossoverCopy(crossover);
+	crossover.setup(1000, otherFrequencies);
+	assert_print(fabs(crossoverCopy.getCrossoverFrequency(0) - 0.1) < 1E-12,
+		     "Copy of a Crossover shares the coefficients of the original.\n");
+	Iir::FilterBank<12, 2> bank;
+	bank.setup(1000, 1, 30, 300);
+	Iir::FilterBank<12, 2> bankCopy(bank);
+	bank.setup(1000, 3, 30, 300);
+	assert_print(bankCopy.getNumBands() == 4, "Number of bands lost when copying.\n");
+	assert_print(fabs(bankCopy.getCenterFrequency(0) - 31.62 / 1000) < 1E-3,
+		     "Copy of a FilterBank shares the band edges of the original.\n");
+
+	// the common filters live in the buffer
+	Iir::AnyFilter any(lp);
+	assert_print(!any.empty(), "Handle is empty.\n");
+	assert_print(!any.isOnHeap(), "Butterworth LowPass<8> allocated on the heap.\n");
+	compare(lp, any, "Butterworth LowPass<8>");
+
+	Iir::RBJ::IIRNotch notch;
+	notch.setup(1000, 50);
+	any = notch;
+	assert_print(!any.isOnHeap(), "RBJ IIRNotch allocated on the heap.\n");
+	compare(notch, any, "RBJ IIRNotch");
+
+	Iir::ChebyshevII::BandStop<6> bs;
+	bs.setup(1000, 50, 5, 40);
+	any = bs;
+	assert_print(!any.isOnHeap(), "ChebyshevII BandStop<6> allocated on the heap.\n");
+	compare(bs, any, "ChebyshevII BandStop<6>");
+	assert_print(any.hasResponse(), "No response.\n");
+	assert_print(std::abs(any.response(50.0 / 1000) - bs.response(50.0 / 1000)) < 1E-12,
+		     "Response differs.\n");
+
+	// large filters go on the heap
+	Iir::Butterworth::BandStop<16> large;
+	large.setup(1000, 50, 5);
+	Iir::AnyFilter anyLarge(large);
+	assert_print(anyLarge.isOnHeap(), "Large filter should be on the heap.\n");
+	compare(large, anyLarge, "Butterworth BandStop<16>");
+
+	// in-place construction and typed access
+	Iir::AnyFilter emplaced;
+	assert_print(emplaced.empty(), "Handle should be empty.\n");
+	emplaced.emplace<Iir::ChebyshevI::HighPass<4>>().setup(1000, 10, 1);
+	assert_print(emplaced.get<Iir::ChebyshevI::HighPass<4>>() != nullptr, "Typed access failed.\n");
+	assert_print(emplaced.get<Iir::ChebyshevI::LowPass<4>>() == nullptr, "Wrong type returned.\n");
+
+	// copies and moves of the handle keep their own filters
+	Iir::AnyFilter copy(any);
+	Iir::AnyFilter moved(std::move(anyLarge));
+	assert_print(anyLarge.empty(), "Moved from handle should be empty.\n");
+	compare(bs, copy, "copy");
+	compare(large, moved, "move");
+	any.get<Iir::ChebyshevII::BandStop<6>>()->setup(1000, 100, 5, 40);
+	assert_print(std::abs(copy.response(50.0 / 1000) - bs.response(50.0 / 1000)) < 1E-12,
+		     "Copy shares the filter with the original.\n");
+
+	// float blocks, strides and filters without response()
+	const double sos[2][6] = {
+		{1, 2, 1, 1, -1.1430, 0.4128},
+		{1, -2, 1, 1, -1.9, 0.91}
+	};
+	Iir::Custom::SOSCascade<2> cascade(sos);
+	Iir::AnyFilter anySos(cascade);
+	assert_print(!anySos.hasResponse(), "SOSCascade has no response.\n");
+	std::vector<float> xf(2 * n), yf(2 * n), yAny(2 * n);
+	for (int i = 0; i < 2 * n; i++) xf[i] = (float)sin(0.05 * i);
+	cascade.filter(xf.data(), n, yf.data(), 2, 2);
+	anySos.filter(xf.data(), n, yAny.data(), 2, 2);
+	for (int i = 0; i < n; i++) {
+		assert_print(yf[2 * i] == yAny[2 * i], "Float block differs.\n");
+	}
+
+	// handles are used like any other filter in the interleaved helper
+	std::vector<Iir::AnyFilter> channels(2, Iir::AnyFilter(notch));
+	channels[0].reset();
+	channels[1].reset();
+	Iir::filterInterleaved(channels.data(), 2, xf.data(), n, yAny.data());
+	for (int c = 0; c < 2; c++) {
+		Iir::RBJ::IIRNotch direct(notch);
+		direct.reset();
+		for (int i = 0; i < n; i++) {
+			const float y = direct.filter(xf[2 * i + c]);
+			assert_print(yAny[2 * i + c] == y, "Interleaved handle differs from the filter.\n");
+		}
+	}
+
+	// growing a vector of handles moves them instead of copying
+	static_assert(std::is_nothrow_move_constructible<Iir::AnyFilter>::value,
+		      "AnyFilter needs a noexcept move constructor.");
+	static_assert(std::is_nothrow_move_assignable<Iir::AnyFilter>::value,
+		      "AnyFilter needs a noexcept move assignment.");
+	channels.reserve(channels.capacity() + 1);
+	assert_print(std::abs(channels[1].response(0.05) - notch.response(0.05)) < 1E-12,
+		     "Handle lost its filter when the vector grew.\n");
+
+	return 0;
+}
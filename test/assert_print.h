@@ -7,6 +7,15 @@ inline void assert_print(int b, const char* t) {
 	abort();
 }
 
+// compares the complex responses of two filters from DC to Nyquist
+template<class FilterA, class FilterB>
+void assert_same_response(FilterA& a, FilterB& b, const char* t) {
+	for (double f = 0.001; f < 0.5; f += 0.007) {
+		const double d = std::abs(a.response(f) - b.response(f));
+		assert_print(d < 1E-9 * (1 + std::abs(b.response(f))), t);
+	}
+}
+
 // placed there so that it only affects the cpp files
 using namespace std;
 
@@ -42,5 +42,21 @@ int main (int,char**)
 		fprintf(stderr,"Correct bandpass exception thrown for fc = fs/2: %s\n",e.what());
 	}
 	
+	try {
+		Iir::Butterworth::LowShelf<3> f;
+		f.setGain(6);
+		assert_print(0,"No exception thrown by setGain() before setup().");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr,"Correct shelf exception thrown for setGain() before setup(): %s\n",e.what());
+	}
+	
+	try {
+		Iir::RBJ::LowShelf f;
+		f.setGain(6);
+		assert_print(0,"No exception thrown by RBJ setGain() before setup().");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr,"Correct RBJ shelf exception thrown for setGain() before setup(): %s\n",e.what());
+	}
+	
 	return 0;
 }
@@ -0,0 +1,198 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+template<class Filter>
+void checkDecimate(Filter& full, Filter& decimating, const int M) {
+	const int n = 1200;
+	double x[n];
+	double y[n];
+	for (int i = 0; i < n; i++) x[i] = sin(0.01 * i) + 0.5 * cos(0.37 * i * i);
+	const int m = decimating.filterDecimate(x, n, M, y);
+	assert_print(m == n / M, "Wrong number of decimated samples.\n");
+	for (int i = 0; i < n; i++) {
+		const double b = full.filter(x[i]);
+		if ((i % M) == 0) {
+			assert_print(fabs(b - y[i / M]) < 1E-12, "Decimated output differs from the full output.\n");
+		}
+	}
+}
+
+int main(int, char**)
+{
+	const double fs = 48000;
+	const double fc = 2000;
+
+	Iir::Butterworth::LowPass<6> f1;
+	Iir::Butterworth::LowPass<6> d1;
+	f1.setup(fs, fc);
+	d1.setup(fs, fc);
+	checkDecimate(f1, d1, 4);
+
+	Iir::ChebyshevI::LowPass<5, Iir::DirectFormI> f2;
+	Iir::ChebyshevI::LowPass<5, Iir::DirectFormI> d2;
+	f2.setup(fs, fc, 1);
+	d2.setup(fs, fc, 1);
+	checkDecimate(f2, d2, 3);
+
+	Iir::ChebyshevII::LowPass<4, Iir::TransposedDirectFormII> f3;
+	Iir::ChebyshevII::LowPass<4, Iir::TransposedDirectFormII> d3;
+	f3.setup(fs, fc, 40);
+	d3.setup(fs, fc, 40);
+	checkDecimate(f3, d3, 1);
+
+	// states without advance() of their own
+	Iir::Butterworth::LowPass<4, Iir::StateVariableForm> f4;
+	Iir::Butterworth::LowPass<4, Iir::StateVariableForm> d4;
+	f4.setup(fs, fc);
+	d4.setup(fs, fc);
+	checkDecimate(f4, d4, 4);
+
+	Iir::Butterworth::LowPass<4, Iir::CoupledForm> f5;
+	Iir::Butterworth::LowPass<4, Iir::CoupledForm> d5;
+	f5.setup(fs, fc);
+	d5.setup(fs, fc);
+	checkDecimate(f5, d5, 2);
+
+	Iir::ChebyshevI::LowPass<4, Iir::LatticeLadder> f6;
+	Iir::ChebyshevI::LowPass<4, Iir::LatticeLadder> d6;
+	f6.setup(fs, fc, 1);
+	d6.setup(fs, fc, 1);
+	checkDecimate(f6, d6, 3);
+
+	// interleaved buffer of 3 channels filtered in place
+	const int channels = 3;
+	const int frames = 1000;
+	float buffer[channels * frames];
+	for (int i = 0; i < frames; i++)
+		for (int c = 0; c < channels; c++)
+			buffer[i * channels + c] = (float)sin(0.01 * (c + 1) * i);
+	Iir::Butterworth::HighPass<4> hp[channels];
+	Iir::Butterworth::HighPass<4> ref[channels];
+	Iir::RBJ::LowPass rbj[channels];
+	Iir::RBJ::LowPass rbjRef[channels];
+	for (int c = 0; c < channels; c++) {
+		hp[c].setup(fs, 100);
+		ref[c].setup(fs, 100);
+		rbj[c].setup(fs, 5000);
+		rbjRef[c].setup(fs, 5000);
+	}
+	float expected[channels * frames];
+	for (int i = 0; i < frames; i++)
+		for (int c = 0; c < channels; c++)
+			expected[i * channels + c] = rbjRef[c].filter(ref[c].filter(buffer[i * channels + c]));
+	Iir::filterInterleaved(hp, channels, buffer, frames, buffer);
+	Iir::filterInterleaved(rbj, channels, buffer, frames, buffer);
+	for (int i = 0; i < channels * frames; i++) {
+		assert_print(buffer[i] == expected[i], "Interleaved output differs from sample by sample filtering.\n");
+	}
+
+	// strided read into a contiguous output
+	double y[frames];
+	double yRef[frames];
+	double z[2 * frames];
+	for (int i = 0; i < 2 * frames; i++) z[i] = cos(0.002 * i);
+	Iir::ChebyshevII::BandStop<4> bs;
+	Iir::ChebyshevII::BandStop<4> bsRef;
+	bs.setup(fs, 1000, 200, 40);
+	bsRef.setup(fs, 1000, 200, 40);
+	bs.filter(z + 1, frames, y, 2);
+	for (int i = 0; i < frames; i++) yRef[i] = bsRef.filter(z[2 * i + 1]);
+	for (int i = 0; i < frames; i++) {
+		assert_print(y[i] == yRef[i], "Strided output differs from sample by sample filtering.\n");
+	}
+
+	// statistics of the output block
+	Iir::BlockStatistics stats;
+	bs.reset();
+	bs.filter(z, 2 * frames, z, stats);
+	double peak = 0;
+	double sum = 0;
+	double mn = z[0];
+	double mx = z[0];
+	for (int i = 0; i < 2 * frames; i++) {
+		if (fabs(z[i]) > peak) peak = fabs(z[i]);
+		if (z[i] < mn) mn = z[i];
+		if (z[i] > mx) mx = z[i];
+		sum += z[i] * z[i];
+	}
+	assert_print(stats.numSamples == 2 * frames, "Wrong number of samples in the statistics.\n");
+	assert_print(stats.peak == peak, "Wrong peak.\n");
+	assert_print(stats.min == mn, "Wrong minimum.\n");
+	assert_print(stats.max == mx, "Wrong maximum.\n");
+	assert_print(fabs(stats.sumOfSquares - sum) < 1E-9, "Wrong sum of squares.\n");
+	assert_print(fabs(stats.getRMS() - sqrt(sum / (2 * frames))) < 1E-12, "Wrong RMS.\n");
+
+	Iir::RBJ::HighPass rhp;
+	rhp.setup(fs, 100);
+	float step[100];
+	for (int i = 0; i < 100; i++) step[i] = 1;
+	rhp.filter(step, 100, step, stats);
+	mx = step[0];
+	for (int i = 0; i < 100; i++) if (step[i] > mx) mx = step[i];
+	assert_print(stats.max == mx, "Wrong RBJ maximum.\n");
+	assert_print(stats.numSamples == 100, "Wrong number of RBJ samples.\n");
+
+	// an empty block after reset() looks like a new object, a block
+	// with only negative samples has a negative maximum
+	const Iir::BlockStatistics fresh;
+	rhp.filter(step, 0, step, stats);
+	assert_print((stats.min == fresh.min) && (stats.max == fresh.max) && (stats.peak == fresh.peak),
+		"Empty block differs from a new object.\n");
+	assert_print((stats.min == 0) && (stats.max == 0) && (stats.numSamples == 0), "Empty block not zero.\n");
+	for (int i = 0; i < 100; i++) step[i] = -1.0f - (float)i;
+	Iir::RBJ::AllPass rap;
+	rap.setup(fs, 1000);
+	rap.filter(step, 100, step, stats);
+	mx = step[0];
+	mn = step[0];
+	for (int i = 0; i < 100; i++) {
+		if (step[i] > mx) mx = step[i];
+		if (step[i] < mn) mn = step[i];
+	}
+	assert_print(stats.max == mx, "Wrong maximum of a negative block.\n");
+	assert_print(stats.min == mn, "Wrong minimum of a negative block.\n");
+
+	// baseline removal, input gain and dry/wet mix
+	Iir::BlockMix mix;
+	mix.inputGain = 0.5;
+	mix.inputOffset = -2250;
+	mix.wetGain = 0.7;
+	mix.dryGain = 0.3;
+	Iir::RBJ::IIRNotch notch;
+	Iir::RBJ::IIRNotch notchRef;
+	notch.setup(1000, 50);
+	notchRef.setup(1000, 50);
+	Iir::Butterworth::LowPass<4> lpMix;
+	Iir::Butterworth::LowPass<4> lpMixRef;
+	lpMix.setup(1000, 100);
+	lpMixRef.setup(1000, 100);
+	float ecg[frames];
+	float ecg2[frames];
+	for (int i = 0; i < frames; i++) ecg[i] = ecg2[i] = (float)(4500 + 100 * sin(0.3 * i));
+	lpMix.filter(ecg, frames, ecg, mix);
+	notch.filter(ecg2, frames, ecg2, mix);
+	for (int i = 0; i < frames; i++) {
+		const double x = 4500 + 100 * sin(0.3 * i);
+		const double u = 0.5 * (float)x - 2250;
+		const float e1 = (float)(0.7 * lpMixRef.filter(u) + 0.3 * u);
+		const float e2 = (float)(0.7 * notchRef.filter(u) + 0.3 * u);
+		assert_print(fabs(ecg[i] - e1) < 1E-3, "Cascade block mix wrong.\n");
+		assert_print(fabs(ecg2[i] - e2) < 1E-3, "RBJ block mix wrong.\n");
+	}
+
+	try {
+		double x[10] = {};
+		double y[10];
+		d1.filterDecimate(x, 10, 4, y);
+		assert_print(0, "No exception thrown for a block which isn't a multiple of M.");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr, "Correct exception thrown: %s\n", e.what());
+	}
+
+	return 0;
+}
@@ -85,5 +85,48 @@ int main(int, char**)
 		}
 	}
 
+	// setGain() needs to give the same filter as a new setup() with that gain
+	Iir::Butterworth::LowShelf<4> ls, lsRef;
+	ls.setup(1000, 100, 6);
+	ls.setGain(-12);
+	lsRef.setup(1000, 100, -12);
+	assert_same_response(ls, lsRef, "LowShelf setGain() differs from setup().\n");
+	assert_print(fabs(20 * log10(std::abs(ls.response(0))) + 12) < 1E-6, "Wrong shelf gain.\n");
+	Iir::Butterworth::HighShelf<5> hs, hsRef;
+	hs.setup(1000, 100, 6);
+	hs.setGain(3);
+	hsRef.setup(1000, 100, 3);
+	assert_same_response(hs, hsRef, "HighShelf setGain() differs from setup().\n");
+	Iir::Butterworth::BandShelf<3> bsh, bshRef;
+	bsh.setup(1000, 100, 20, 6);
+	bsh.setGain(-9);
+	bshRef.setup(1000, 100, 20, -9);
+	assert_same_response(bsh, bshRef, "BandShelf setGain() differs from setup().\n");
+	bsh.setup(1000, 300, 20, 6);
+	bsh.setGain(9);
+	bshRef.setup(1000, 300, 20, 9);
+	assert_same_response(bsh, bshRef, "BandShelf setGain() differs from setup().\n");
+	assert_print(bsh.getPoleZeros().size() == 3, "No poles/zeros after setGain().\n");
+
+	// the normalisation at DC and Nyquist is calculated with real numbers and
+	// needs to agree with the complex response as before
+	Iir::Butterworth::LowPass<5> lpNorm;
+	lpNorm.setupN(0.1);
+	assert_print(fabs(std::abs(lpNorm.response(0)) - 1) < 1E-12, "Lowpass not normalised at DC.\n");
+	Iir::Butterworth::HighPass<5> hpNorm;
+	hpNorm.setupN(0.1);
+	assert_print(fabs(std::abs(hpNorm.response(0.5)) - 1) < 1E-12, "Highpass not normalised at Nyquist.\n");
+	Iir::Butterworth::BandStop<4> bsNorm;
+	bsNorm.setupN(0.1, 0.05);
+	assert_print(fabs(std::abs(bsNorm.response(0.5)) - 1) < 1E-12, "Bandstop not normalised at Nyquist.\n");
+	bsNorm.setupN(0.3, 0.05);
+	assert_print(fabs(std::abs(bsNorm.response(0)) - 1) < 1E-12, "Bandstop not normalised at DC.\n");
+	Iir::Butterworth::LowShelf<4> lsNorm;
+	lsNorm.setupN(0.1, 6);
+	assert_print(fabs(std::abs(lsNorm.response(0.5)) - 1) < 1E-12, "LowShelf not normalised at Nyquist.\n");
+	Iir::Butterworth::HighShelf<4> hsNorm;
+	hsNorm.setupN(0.1, 6);
+	assert_print(fabs(std::abs(hsNorm.response(0)) - 1) < 1E-12, "HighShelf not normalised at DC.\n");
+
 	return 0;
 }
@@ -54,6 +54,30 @@ int main(int, char**)
 		}
 	}
 
+	// setGain() needs to give the same filter as a new setup() with that gain
+	Iir::ChebyshevI::LowShelf<4> ls, lsRef;
+	ls.setup(1000, 100, 6, 0.5);
+	ls.setGain(-12);
+	lsRef.setup(1000, 100, -12, 0.5);
+	assert_same_response(ls, lsRef, "LowShelf setGain() differs from setup().\n");
+	Iir::ChebyshevI::HighShelf<5> hs, hsRef;
+	hs.setup(1000, 100, 6, 0.5);
+	hs.setGain(3);
+	hsRef.setup(1000, 100, 3, 0.5);
+	assert_same_response(hs, hsRef, "HighShelf setGain() differs from setup().\n");
+	Iir::ChebyshevI::BandShelf<4> bsh, bshRef;
+	bsh.setup(1000, 100, 20, 6, 0.5);
+	bsh.setGain(-9);
+	bshRef.setup(1000, 100, 20, -9, 0.5);
+	assert_same_response(bsh, bshRef, "BandShelf setGain() differs from setup().\n");
+
+	// the normalisation at DC is calculated with real numbers and needs to
+	// agree with the complex response as before (even order: -ripple at DC)
+	Iir::ChebyshevI::LowPass<4> lpNorm;
+	lpNorm.setupN(0.1, 1);
+	assert_print(fabs(std::abs(lpNorm.response(0)) - pow(10, -1 / 20.)) < 1E-12,
+		     "Lowpass not normalised at DC.\n");
+
 	return 0;
 
 
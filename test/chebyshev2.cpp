@@ -62,5 +62,22 @@ int main(int, char**)
 
 
 
+	// setGain() needs to give the same filter as a new setup() with that gain
+	Iir::ChebyshevII::LowShelf<4> ls, lsRef;
+	ls.setup(1000, 100, 6, 20);
+	ls.setGain(-12);
+	lsRef.setup(1000, 100, -12, 20);
+	assert_same_response(ls, lsRef, "LowShelf setGain() differs from setup().\n");
+	Iir::ChebyshevII::HighShelf<5> hs, hsRef;
+	hs.setup(1000, 100, 6, 20);
+	hs.setGain(3);
+	hsRef.setup(1000, 100, 3, 20);
+	assert_same_response(hs, hsRef, "HighShelf setGain() differs from setup().\n");
+	Iir::ChebyshevII::BandShelf<4> bsh, bshRef;
+	bsh.setup(1000, 100, 20, 6, 20);
+	bsh.setGain(-9);
+	bshRef.setup(1000, 100, 20, -9, 20);
+	assert_same_response(bsh, bshRef, "BandShelf setGain() differs from setup().\n");
+
 	return 0;
 }
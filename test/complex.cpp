@@ -0,0 +1,53 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+// The complex filter needs to be identical to two real filters
+// which filter the real and imaginary parts separately.
+template<class ComplexState, class RealState>
+void checkComplex() {
+	Iir::Butterworth::LowPass<4, ComplexState> fc;
+	Iir::Butterworth::LowPass<4, RealState> fi;
+	Iir::Butterworth::LowPass<4, RealState> fq;
+	fc.setup(48000, 1000);
+	fi.setup(48000, 1000);
+	fq.setup(48000, 1000);
+	for (int i = 0; i < 10000; i++) {
+		const std::complex<double> x(sin(0.1 * i), cos(0.37 * i));
+		const std::complex<double> y = fc.filter(x);
+		assert_print(!isnan(y.real()) && !isnan(y.imag()), "Complex output is NAN\n");
+		assert_print(fabs(y.real() - fi.filter(x.real())) < 1E-12, "Real part differs.\n");
+		assert_print(fabs(y.imag() - fq.filter(x.imag())) < 1E-12, "Imaginary part differs.\n");
+	}
+}
+
+int main(int, char**)
+{
+	checkComplex<Iir::ComplexDirectFormI, Iir::DirectFormI>();
+	checkComplex<Iir::ComplexDirectFormII, Iir::DirectFormII>();
+	checkComplex<Iir::ComplexTransposedDirectFormII, Iir::TransposedDirectFormII>();
+
+	// a negative frequency passes through a lowpass just like a positive one
+	Iir::ChebyshevI::LowPass<6, Iir::ComplexDirectFormII> f;
+	const double fs = 1000;
+	f.setup(fs, 50, 1);
+	std::complex<float> y;
+	for (int i = 0; i < 10000; i++) {
+		const std::complex<float> x = std::polar(1.0f, (float)(-2 * M_PI * 10 * i / fs));
+		y = f.filter(x);
+	}
+	fprintf(stderr, "|y| = %f\n", std::abs(y));
+	assert_print(fabs(std::abs(y) - 1) < 0.13, "Negative frequency not passed.\n");
+	for (int i = 0; i < 10000; i++) {
+		const std::complex<float> x = std::polar(1.0f, (float)(-2 * M_PI * 200 * i / fs));
+		y = f.filter(x);
+	}
+	fprintf(stderr, "|y| = %f\n", std::abs(y));
+	assert_print(std::abs(y) < 1E-3, "Negative frequency in the stopband not removed.\n");
+
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include "Iir.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <thread>
+#include <vector>
+
+#include "assert_print.h"
+
+// each thread filters its own signal but accounts in the shared counter
+void filterInThread(Iir::CycleCounter<true>* counter, int numCalls)
+{
+	Iir::Butterworth::LowPass<4> f;
+	f.setup(48000, 1000);
+	const int n = 64;
+	double x[n];
+	for (int c = 0; c < numCalls; c++) {
+		for (int i = 0; i < n; i++) x[i] = sin(0.1 * i);
+		Iir::filterAccounted(f, *counter, x, n, x);
+	}
+}
+
+int main(int, char**)
+{
+	Iir::Butterworth::LowPass<8> f;
+	f.setup(48000, 1000);
+	Iir::CycleCounter<true> counter(4);
+
+	const int n = 256;
+	double x[n];
+	for (int i = 0; i < n; i++) x[i] = sin(0.1 * i);
+	for (int c = 0; c < 100; c++) {
+		Iir::filterAccounted(f, counter, x, n, x);
+	}
+
+	const Iir::CycleSnapshot s = counter.snapshot();
+	fprintf(stderr, "calls = %lu, sampled = %lu, cycles/sample = %f\n",
+		(unsigned long)s.calls, (unsigned long)s.sampledCalls, s.getCyclesPerSample());
+	assert_print(s.calls == 100, "Wrong number of calls.\n");
+	assert_print(s.sampledCalls == 25, "Wrong number of timed calls.\n");
+	assert_print(s.samples == 25 * n, "Wrong number of timed samples.\n");
+	assert_print(s.getCyclesPerSample() > 0, "No cycles counted.\n");
+
+	counter.reset();
+	assert_print(counter.snapshot().calls == 0, "Counter not reset.\n");
+
+	// more threads than private counters so that some share the last one
+	const int numThreads = Iir::CycleCounter<true>::MaxThreads + 4;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < numThreads; t++) {
+		threads.push_back(std::thread(filterInThread, &counter, 1000));
+	}
+	for (auto& t : threads) t.join();
+	const Iir::CycleSnapshot st = counter.snapshot();
+	fprintf(stderr, "threads: calls = %lu, sampled = %lu\n",
+		(unsigned long)st.calls, (unsigned long)st.sampledCalls);
+	assert_print(st.calls == (uint64_t) numThreads * 1000, "Calls lost between threads.\n");
+	assert_print(st.samples == st.sampledCalls * 64, "Timed samples lost between threads.\n");
+	assert_print(st.sampledCalls >= (uint64_t) numThreads * 1000 / 4 - 4 * 4, "Too few timed calls.\n");
+
+	// threads which have exited hand their counters back
+	for (int t = 0; t < numThreads; t++) {
+		unsigned index = 0;
+		std::thread([&index]() { index = Iir::CycleAccountingThread::getIndex(); }).join();
+		assert_print(index < Iir::CycleAccountingThread::MaxThreads, "Thread index not reused.\n");
+	}
+
+	// switched off nothing is counted
+	Iir::CycleCounter<false> off(1);
+	for (int c = 0; c < 10; c++) {
+		Iir::filterAccounted(f, off, x, n, x);
+	}
+	assert_print(off.snapshot().calls == 0, "Switched off counter counts.\n");
+	assert_print(sizeof(off) < sizeof(counter), "Switched off counter has counters.\n");
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+#include <stdexcept>
+#include <string>
+
+#include "assert_print.h"
+
+// checks that the factory designs the same filter as the template
+template<class Filter>
+void compare(const char* spec, Filter& f) {
+	Iir::AnyFilter any = Iir::makeFilter(spec);
+	f.reset();
+	for (int i = 0; i < 2000; i++) {
+		const double x = sin(0.01 * i) + 0.5 * sin(0.3 * i) + (i == 10 ? 1 : 0);
+		const double y = f.filter(x);
+		const double yAny = any.filter(x);
+		assert_print(fabs(y - yAny) < 1E-12 * (1 + fabs(y)), "Factory designed a different filter.\n");
+	}
+	fprintf(stderr, "%s: %s\n", spec, any.isOnHeap() ? "heap" : "buffer");
+}
+
+bool throws(const char* spec) {
+	try {
+		Iir::makeFilter(spec);
+	} catch (const std::invalid_argument&) {
+		return true;
+	}
+	return false;
+}
+
+int main(int, char**)
+{
+	Iir::Butterworth::BandStop<4> bs;
+	bs.setup(1000, 50, 5);
+	compare("butterworth:bandstop:order=4:fc=50:bw=5:fs=1000", bs);
+
+	Iir::Butterworth::LowPass<8> lp;
+	lp.setup(6, 1000, 100);
+	compare("Butterworth : LowPass : order=6 : fc=100 : fs=1000", lp);
+
+	Iir::ChebyshevI::HighShelf<3> cheby1;
+	cheby1.setup(48000, 1000, 6, 0.5);
+	compare("chebyshev1:highshelf:order=3:fc=1000:gain=6:ripple=0.5:fs=48000", cheby1);
+
+	Iir::ChebyshevII::BandStop<6> cheby2;
+	cheby2.setup(1000, 50, 5, 40);
+	compare("chebyshev2:bandstop:order=6:fc=50:bw=5:stopband=40:fs=1000", cheby2);
+
+	Iir::RBJ::IIRNotch notch;
+	notch.setup(1000, 50, 20);
+	compare("rbj:iirnotch:fc=50:q=20:fs=1000", notch);
+
+	Iir::RBJ::LowShelf shelf;
+	shelf.setupN(0.1, -3);
+	compare("rbj:lowshelf:fc=0.1:gain=-3", shelf);
+
+	// the custom biquads run as a cascade of one stage
+	Iir::Custom::OnePole onePole;
+	onePole.setup(0.05, 0.9, -1);
+	const double sos[1][6] = {{onePole.getB0(), onePole.getB1(), onePole.getB2(),
+				   onePole.getA0(), onePole.getA1(), onePole.getA2()}};
+	Iir::Custom::SOSCascade<1> custom(sos);
+	compare("custom:onepole:scale=0.05:pole=0.9:zero=-1", custom);
+	assert_print(!throws("custom:twopole:polerho=0.9:poletheta=0.3:zerorho=1:zerotheta=2"),
+		     "Two pole filter rejected.\n");
+
+	// canonical form
+	assert_print(Iir::FilterSpec::parse("RBJ:IIRNotch:fs=1000:fc=50").toString() ==
+		     "rbj:iirnotch:fc=50:fs=1000", "Spec not canonical.\n");
+	// with the defaults and normalised frequencies
+	assert_print(Iir::FilterSpec::parse("rbj:iirnotch:fc=50:fs=1000").canonical().toString() ==
+		     Iir::FilterSpec::parse("rbj:iirnotch:fc=0.05:q=10").canonical().toString(),
+		     "Default or fs not canonical.\n");
+	const Iir::FilterSpec cheby = Iir::FilterSpec::parse("chebyshevi:lowpass:order=2:fc=1:ripple=1:fs=10");
+	assert_print(cheby.canonical().toString() == "chebyshev1:lowpass:fc=0.10000000000000001:order=2:ripple=1",
+		     "Family not canonical.\n");
+
+	// errors
+	assert_print(throws("butterworth"), "Missing type accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=4"), "Missing fc accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=4:fc=10:foo=1"), "Unknown key accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=4:fc=1x"), "Invalid value accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=4:order=2:fc=0.1"), "Duplicate key accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=17:fc=0.1"), "Order too high accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=2.5:fc=0.1"), "Fractional order accepted.\n");
+	assert_print(throws("butterworth:comb:order=2:fc=0.1"), "Unknown type accepted.\n");
+	assert_print(throws("elliptic:lowpass:order=2:fc=0.1"), "Unknown family accepted.\n");
+	assert_print(throws("butterworth::order=2:fc=0.1"), "Empty field accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=1e10:fc=0.1"), "Huge order accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=-3:fc=0.1"), "Negative order accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=4:fc=0.1:q=2"), "Unused q accepted.\n");
+	assert_print(throws("butterworth:lowpass:order=4:fc=0.1:gain=6"), "Unused gain accepted.\n");
+	assert_print(throws("chebyshev1:lowpass:order=4:fc=0.1:ripple=1:stopband=40"),
+		     "Unused stopband accepted.\n");
+	assert_print(throws("rbj:lowpass:fc=0.1:order=4"), "Unused order accepted.\n");
+	assert_print(throws("rbj:iirnotch:fc=0.1:slope=1"), "Unused slope accepted.\n");
+	assert_print(!throws("rbj:lowshelf:fc=0.1:gain=3:slope=1"), "Shelf slope rejected.\n");
+	assert_print(throws("butterworth:lowpass:order=4:fc=10:fs=0"), "Zero fs accepted.\n");
+	assert_print(throws("custom:onepole:pole=0.5:zero=0:polerho=1"), "Unused polerho accepted.\n");
+
+	// the cache designs every filter only once
+	Iir::FilterFactory factory;
+	Iir::AnyFilter a = factory.create("butterworth:lowpass:order=4:fc=10:fs=1000");
+	Iir::AnyFilter b = factory.create("butterworth:lowpass:fs=1000:fc=10:order=4");
+	Iir::AnyFilter c = factory.create("butterworth:lowpass:order=4:fc=20:fs=1000");
+	assert_print(factory.getCacheSize() == 2, "Equal specs designed twice.\n");
+	factory.create("butterworth:lowpass:order=4:fc=0.01");
+	assert_print(factory.getCacheSize() == 2, "Normalised spec designed twice.\n");
+	factory.create("rbj:iirnotch:fc=50:fs=1000");
+	factory.create("rbj:iirnotch:fc=0.05:q=10");
+	assert_print(factory.getCacheSize() == 3, "Default q designed twice.\n");
+	// every filter has its own delay lines
+	for (int i = 0; i < 100; i++) a.filter(1.0);
+	assert_print(b.filter(1.0) != a.filter(1.0), "Filters from the cache share their state.\n");
+	assert_print(std::abs(b.response(0.01) - a.response(0.01)) < 1E-15, "Cached design differs.\n");
+	assert_print(std::abs(c.response(0.01) - a.response(0.01)) > 1E-3, "Wrong design from cache.\n");
+	factory.clearCache();
+	assert_print(factory.getCacheSize() == 0, "Cache not cleared.\n");
+
+	// a failed design must not leave anything in the cache
+	for (int i = 0; i < 2; i++) {
+		bool thrown = false;
+		try {
+			factory.create("butterworth:lowpass:order=4:fs=1000");
+		} catch (const std::invalid_argument& e) {
+			fprintf(stderr, "Correct exception thrown: %s\n", e.what());
+			thrown = true;
+		}
+		assert_print(thrown, "Failed design returned from the cache.\n");
+	}
+	assert_print(factory.getCacheSize() == 0, "Failed design cached.\n");
+
+	// the cache is bounded
+	Iir::FilterFactory small(2);
+	for (int i = 1; i <= 10; i++) {
+		const std::string spec = "rbj:lowpass:fc=" + std::to_string(i * 10) + ":fs=1000";
+		Iir::AnyFilter f = small.create(spec);
+		assert_print(std::abs(f.response(0) - 1.0) < 1E-9, "Wrong design from a bounded cache.\n");
+	}
+	assert_print(small.getCacheSize() == 2, "Cache not bounded.\n");
+
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+int main(int, char**)
+{
+	const double fs = 48000;
+	const int order = 3;
+
+	// third-octave bank from 20Hz to 20kHz
+	Iir::FilterBank<32, order> bank;
+	bank.setup(fs, 3, 20, 20000);
+	fprintf(stderr, "Number of bands: %d\n", bank.getNumBands());
+	assert_print(bank.getNumBands() == 31, "Wrong number of third-octave bands.\n");
+	assert_print(fabs(bank.getCenterFrequency(17) * fs - 1000) < 20,
+		     "Third-octave band 17 is not at 1kHz.\n");
+
+	// every band needs to be identical to a separate bandpass
+	Iir::Butterworth::BandPass<order> ref[31];
+	for (int b = 0; b < bank.getNumBands(); b++) {
+		const double lower = bank.getLowerEdge(b);
+		const double upper = bank.getUpperEdge(b);
+		ref[b].setupN((lower + upper) / 2, upper - lower);
+	}
+
+	double y[32];
+	for (int i = 0; i < 10000; i++) {
+		double a = 0;
+		if (i == 10) a = 1;
+		bank.filter(a, y);
+		for (int b = 0; b < bank.getNumBands(); b++) {
+			const double r = ref[b].filter(a);
+			assert_print(!isnan(y[b]), "Filterbank output is NAN\n");
+			assert_print(fabs(y[b] - r) < 1E-12,
+				     "Filterbank output differs from the bandpass.\n");
+		}
+	}
+
+	// the energy of a 1kHz sine needs to end up in the 1kHz band
+	bank.reset();
+	const int n = 4800;
+	double x[n];
+	double energies[32];
+	for (int i = 0; i < n; i++) x[i] = sin(2 * M_PI * 1000 / fs * i);
+	bank.filter(x, n, (double**)nullptr, energies);
+	bank.filter(x, n, (double**)nullptr, energies);
+	int maxBand = 0;
+	for (int b = 0; b < bank.getNumBands(); b++) {
+		if (energies[b] > energies[maxBand]) maxBand = b;
+	}
+	fprintf(stderr, "Energy at 1kHz band: %f\n", energies[maxBand]);
+	assert_print(maxBand == 17, "1kHz sine not detected in the 1kHz band.\n");
+	assert_print(fabs(energies[maxBand] / n - 0.5) < 0.05, "Energy of the 1kHz band is wrong.\n");
+
+	// multirate third-octave bank: 6 octaves below 8kHz
+	Iir::MultirateFilterBank<3, 6, order> multirate;
+	multirate.setup(fs, 8000);
+	assert_print(multirate.getNumBands() == 18, "Wrong number of multirate bands.\n");
+	const int lowBand = 2;
+	const double f = multirate.getCenterFrequency(lowBand);
+	fprintf(stderr, "Multirate band %d at %f Hz\n", lowBand, f * fs);
+	assert_print(fabs(f * fs - 8000 / pow(2, 15. / 3.)) < 1E-6, "Multirate band at the wrong frequency.\n");
+	double multirateEnergies[18];
+	const int nm = 48000;
+	double* xm = new double[nm];
+	for (int i = 0; i < nm; i++) xm[i] = sin(2 * M_PI * f * i);
+	multirate.filter(xm, nm, multirateEnergies);
+	multirate.filter(xm, nm, multirateEnergies);
+	for (int b = 0; b < multirate.getNumBands(); b++) {
+		assert_print(!isnan(multirateEnergies[b]), "Multirate output is NAN\n");
+		if (b != lowBand) {
+			assert_print(multirateEnergies[b] < multirateEnergies[lowBand],
+				     "Sine not detected in the right multirate band.\n");
+		}
+	}
+	fprintf(stderr, "Multirate energy: %f\n", multirateEnergies[lowBand] / nm);
+	assert_print(fabs(multirateEnergies[lowBand] / nm - 0.5) < 0.05,
+		     "Energy of the multirate band is wrong.\n");
+	delete[] xm;
+
+	try {
+		Iir::FilterBank<10> small;
+		small.setup(fs, 3, 20, 20000);
+		assert_print(0, "No exception thrown for too many bands.");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr, "Correct exception thrown for too many bands: %s\n", e.what());
+	}
+
+	// a copy needs to keep its own coefficients and band edges
+	Iir::FilterBank<32, order> bankCopy(bank);
+	bank.setup(fs, 1, 100, 1000);
+	assert_print(bankCopy.getNumBands() == 31, "Number of bands lost when copying.\n");
+	assert_print(fabs(bankCopy.getCenterFrequency(17) * fs - 1000) < 20,
+		     "Copy of the bank shares the band edges of the original.\n");
+	bank = bankCopy;
+	bankCopy.setup(fs, 1, 100, 1000);
+	assert_print(fabs(bank.getCenterFrequency(17) * fs - 1000) < 20,
+		     "Assigned bank shares the band edges of the original.\n");
+
+	return 0;
+}
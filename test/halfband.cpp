@@ -0,0 +1,81 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+int main(int, char**)
+{
+	// 48kHz -> 24kHz with a passband up to 20kHz
+	const double fs = 48000;
+	const double transition = 4000;
+	const double stopband = 90;
+
+	Iir::Halfband::Decimator<16> dec;
+	dec.setup(fs, transition, stopband);
+	fprintf(stderr, "Number of coefficients: %d\n", dec.getNumCoefficients());
+	assert_print(dec.getNumCoefficients() > 0, "No coefficients designed.\n");
+
+	// check the design against the specification
+	const double fpass = (fs / 4 - transition / 2) / fs;
+	const double fstop = (fs / 4 + transition / 2) / fs;
+	for (double f = 0; f < 0.5; f += 0.001) {
+		const double g = abs(dec.response(f));
+		if (f < fpass) {
+			assert_print(fabs(g - 1) < 1E-3, "Halfband passband ripple too high.\n");
+		}
+		if (f > fstop) {
+			assert_print(20 * log10(g) < -stopband + 1, "Halfband stopband attenuation too low.\n");
+		}
+	}
+
+	// a sine in the stopband needs to vanish after decimation
+	const int n = 4800;
+	double x[n];
+	double y[n / 2];
+	for (int i = 0; i < n; i++) x[i] = sin(2 * M_PI * 0.4 * i);
+	dec.filter(x, n, y);
+	for (int i = n / 4; i < n / 2; i++) {
+		assert_print(!isnan(y[i]), "Decimator output is NAN\n");
+		assert_print(fabs(y[i]) < 1E-4, "Decimator not removing the stopband sine.\n");
+	}
+
+	// a sine in the passband goes through decimation and interpolation
+	Iir::Halfband::Interpolator<16> interp;
+	interp.setup(fs, transition, stopband);
+	dec.reset();
+	const double f0 = 0.05;
+	double z[n];
+	for (int i = 0; i < n; i++) x[i] = sin(2 * M_PI * f0 * i);
+	dec.filter(x, n, y);
+	interp.filter(y, n / 2, z);
+	double power = 0;
+	for (int i = n / 2; i < n; i++) {
+		assert_print(!isnan(z[i]), "Interpolator output is NAN\n");
+		power += z[i] * z[i];
+	}
+	const double rms = sqrt(power / (n / 2));
+	fprintf(stderr, "RMS after decimation and interpolation: %f\n", rms);
+	assert_print(fabs(rms - sqrt(0.5)) < 1E-2, "Passband sine not preserved.\n");
+
+	try {
+		Iir::Halfband::Decimator<2> small;
+		small.setupN(0.01, 120);
+		assert_print(0, "No exception thrown for too many coefficients.");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr, "Correct exception thrown: %s\n", e.what());
+	}
+
+	// a copy needs to keep its own coefficients
+	Iir::Halfband::Decimator<16> decCopy(dec);
+	const double c0 = dec.getCoefficient(0);
+	dec.setup(fs, 2 * transition, 60);
+	assert_print(decCopy.getCoefficient(0) == c0, "Copy shares the coefficients of the original.\n");
+	dec = decCopy;
+	decCopy.setup(fs, 2 * transition, 60);
+	assert_print(dec.getCoefficient(0) == c0, "Assigned filter shares the coefficients of the original.\n");
+
+	return 0;
+}
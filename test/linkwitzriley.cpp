@@ -0,0 +1,88 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+template<class Crossover>
+void checkCrossover(Crossover& crossover, const int numBands) {
+	// the bands need to sum up to an allpass
+	for (double f = 0.001; f < 0.5; f += 0.001) {
+		Iir::complex_t h = 0;
+		for (int b = 0; b < numBands; b++) h += crossover.response(b, f);
+		assert_print(fabs(abs(h) - 1) < 1E-9, "Bands don't sum up to an allpass.\n");
+	}
+
+	// all bands are -6dB at their crossover frequencies
+	for (int c = 0; c < numBands - 1; c++) {
+		const double fc = crossover.getCrossoverFrequency(c);
+		assert_print(fabs(abs(crossover.response(c, fc)) - 0.5) < 1E-2, "Lower band not -6dB at crossover.\n");
+		assert_print(fabs(abs(crossover.response(c + 1, fc)) - 0.5) < 1E-2, "Upper band not -6dB at crossover.\n");
+	}
+
+	// the summed impulse response of an allpass has unit energy
+	const int n = 20000;
+	double x[n] = {};
+	x[0] = 1;
+	double bands[4][n];
+	double* outputs[4] = { bands[0], bands[1], bands[2], bands[3] };
+	crossover.filter(x, n, outputs);
+	double energy = 0;
+	for (int i = 0; i < n; i++) {
+		double sum = 0;
+		for (int b = 0; b < numBands; b++) {
+			assert_print(!isnan(bands[b][i]), "Crossover output is NAN\n");
+			sum += bands[b][i];
+		}
+		energy += sum * sum;
+	}
+	fprintf(stderr, "Energy of the summed impulse response: %f\n", energy);
+	assert_print(fabs(energy - 1) < 1E-6, "Summed impulse response is not an allpass.\n");
+}
+
+int main(int, char**)
+{
+	const double fs = 48000;
+
+	Iir::LinkwitzRiley::Crossover<2, 4> lr4;
+	lr4.setup(fs, 1000);
+	checkCrossover(lr4, 2);
+
+	Iir::LinkwitzRiley::Crossover<3, 2> lr2;
+	const double f3[] = { 300, 3000 };
+	lr2.setup(fs, f3);
+	checkCrossover(lr2, 3);
+
+	Iir::LinkwitzRiley::Crossover<4, 8> lr8;
+	const double f4[] = { 100, 800, 5000 };
+	lr8.setup(fs, f4);
+	checkCrossover(lr8, 4);
+
+	// stopband of the LR8 lowest band two octaves above its crossover
+	assert_print(20 * log10(abs(lr8.response(0, 400 / fs))) < -90, "LR8 lowpass not steep enough.\n");
+
+	try {
+		Iir::LinkwitzRiley::Crossover<3> bad;
+		const double f[] = { 3000, 300 };
+		bad.setup(fs, f);
+		assert_print(0, "No exception thrown for descending crossover frequencies.");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr, "Correct exception thrown: %s\n", e.what());
+	}
+
+	// a copy needs to keep its own sections
+	Iir::LinkwitzRiley::Crossover<3, 2> lr2Copy(lr2);
+	const double other[] = { 100, 1000 };
+	lr2.setup(fs, other);
+	assert_print(fabs(lr2Copy.getCrossoverFrequency(0) * fs - 300) < 1E-9,
+		     "Copy shares the sections of the original.\n");
+	checkCrossover(lr2Copy, 3);
+	lr2 = lr2Copy;
+	lr2Copy.setup(fs, other);
+	assert_print(fabs(lr2.getCrossoverFrequency(0) * fs - 300) < 1E-9,
+		     "Assigned crossover shares the sections of the original.\n");
+
+	return 0;
+}
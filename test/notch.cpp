@@ -0,0 +1,177 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+#include <stdexcept>
+#include <stdlib.h>
+#include <vector>
+
+#include "assert_print.h"
+
+const double fs = 1000;
+
+// mains hum with a slow drift, a baseline wander and some noise
+double mains(int i, double f, double& phase) {
+	phase += 2 * M_PI * f / fs;
+	const double noise = 0.1 * ((rand() / (double)RAND_MAX) - 0.5);
+	return sin(phase) + 0.3 * sin(2 * M_PI * 3 * i / fs) + noise;
+}
+
+int main(int, char**)
+{
+	srand(1);
+
+	// mains 0.4Hz off the nominal frequency
+	Iir::AdaptiveNotch<> notch;
+	notch.setup(fs, 50, 2, 1);
+	Iir::RBJ::IIRNotch fixed;
+	fixed.setup(fs, 50, 25);
+	double phase = 0;
+	double residual = 0;
+	double residualFixed = 0;
+	for (int i = 0; i < 10000; i++) {
+		const double x = mains(i, 50.4, phase);
+		const double hum = sin(phase);
+		const double y = notch.filter(x);
+		const double yFixed = fixed.filter(x);
+		assert_print(!isnan(y), "Output is NAN\n");
+		if (i >= 5000) {
+			residual += (y - (x - hum)) * (y - (x - hum));
+			residualFixed += (yFixed - (x - hum)) * (yFixed - (x - hum));
+		}
+	}
+	fprintf(stderr, "tracked %f Hz, residual %f (fixed notch %f)\n", notch.getFrequency(), residual,
+		residualFixed);
+	assert_print(fabs(notch.getFrequency() - 50.4) < 0.02, "Notch has not found the mains.\n");
+	assert_print(residual < 0.1 * residualFixed, "Adaptive notch removes less than a fixed one.\n");
+
+	// slow drift from 49.5Hz to 50.5Hz
+	notch.reset();
+	assert_print(fabs(notch.getFrequency() - 50) < 1E-9, "Reset should restore the centre frequency.\n");
+	phase = 0;
+	for (int i = 0; i < 20000; i++) {
+		const double f = 49.5 + i / 20000.0;
+		notch.filter(mains(i, f, phase));
+		if (i > 2000) {
+			assert_print(fabs(notch.getFrequency() - f) < 0.05, "Notch lost track of the mains.\n");
+		}
+	}
+
+	// the frequency stays within the allowed deviation
+	notch.reset();
+	phase = 0;
+	for (int i = 0; i < 10000; i++) notch.filter(mains(i, 53, phase));
+	for (int i = 0; i < 10000; i++) {
+		notch.filter(mains(i, 53, phase));
+		assert_print(notch.getFrequency() < 51 + 1E-9, "Deviation not limited.\n");
+	}
+	fprintf(stderr, "limited to %f Hz\n", notch.getFrequency());
+	assert_print(notch.getFrequency() > 50.9, "Notch does not move towards the mains.\n");
+
+	// frozen notch
+	notch.reset();
+	notch.setAdaptive(false);
+	for (int i = 0; i < 1000; i++) notch.filter(mains(i, 50.4, phase));
+	assert_print(notch.getCoefficient() == -2 * cos(2 * M_PI * 50 / fs), "Frozen notch has moved.\n");
+
+	// three channels of interleaved float frames share one frequency
+	const int channels = 3;
+	const int frames = 256;
+	Iir::AdaptiveNotch<channels> multi;
+	multi.setup(fs, 60, 2, 1);
+	std::vector<float> block(channels * frames);
+	phase = 0;
+	int n = 0;
+	for (int b = 0; b < 40; b++) {
+		for (int i = 0; i < frames; i++, n++) {
+			const double x = mains(n, 59.7, phase);
+			for (int ch = 0; ch < channels; ch++) block[i * channels + ch] = (float)((ch + 1) * x);
+		}
+		multi.filter(block.data(), frames, block.data());
+	}
+	fprintf(stderr, "%d channels tracked %f Hz\n", channels, multi.getFrequency());
+	assert_print(fabs(multi.getFrequency() - 59.7) < 0.02, "Multichannel notch has not found the mains.\n");
+	for (int ch = 0; ch < channels; ch++) {
+		double e = 0;
+		for (int i = 0; i < frames; i++) e += block[i * channels + ch] * block[i * channels + ch];
+		assert_print(sqrt(e / frames) < 0.3 * (ch + 1), "Mains not removed from a channel.\n");
+	}
+
+	// 50Hz and its harmonics up to 450Hz in one cascade
+	Iir::HarmonicNotch<9> harmonics;
+	harmonics.setup(fs, 50, 9, 2);
+	for (int k = 1; k <= 9; k++) {
+		assert_print(std::abs(harmonics.response(k * 50 / fs)) < 1E-6, "Harmonic not notched.\n");
+		assert_print(fabs(std::abs(harmonics.response((k * 50 - 25) / fs)) - 1) < 0.005,
+			     "Notches too wide.\n");
+	}
+
+	// the same as nine RBJ notches with the same width but scaled for unity gain
+	const double rho = exp(-M_PI * 2 / fs);
+	const double gain = pow((1 + rho * rho) / 2, 9);
+	Iir::RBJ::IIRNotch rbj[9];
+	for (int k = 0; k < 9; k++) rbj[k].setup(fs, (k + 1) * 50, (k + 1) * 50 / 2.0);
+	phase = 0;
+	for (int i = 0; i < 5000; i++) {
+		double x = mains(i, 50, phase) + 0.2 * sin(3 * phase);
+		const double y = harmonics.filter(x);
+		for (int k = 0; k < 9; k++) x = rbj[k].filter(x);
+		assert_print(fabs(y - gain * x) < 1E-9, "Harmonic notch differs from RBJ notches.\n");
+	}
+
+	// retuning to a drifted fundamental is the same as a new design
+	Iir::HarmonicNotch<9> copy(harmonics);
+	harmonics.setFundamental(fs, 50.4);
+	Iir::HarmonicNotch<9> designed;
+	designed.setup(fs, 50.4, 9, 2);
+	assert_print(fabs(harmonics.getFundamental() * fs - 50.4) < 1E-9, "Wrong fundamental.\n");
+	for (double f = 10; f < 500; f += 0.7) {
+		assert_print(std::abs(harmonics.response(f / fs) - designed.response(f / fs)) < 1E-9,
+			     "Retuned notch differs from its design.\n");
+	}
+	assert_print(std::abs(copy.response(450 / fs)) < 1E-6, "Copy has been retuned as well.\n");
+
+	// retuning checks the harmonics and the width like setup() and keeps the notches
+	bool retuneThrown = false;
+	try {
+		harmonics.setFundamental(fs, 60);
+	} catch (const std::invalid_argument&) {
+		retuneThrown = true;
+	}
+	assert_print(retuneThrown, "Retuning the 9th harmonic above Nyquist accepted.\n");
+	retuneThrown = false;
+	try {
+		harmonics.setFundamental(fs, 1.5);
+	} catch (const std::invalid_argument&) {
+		retuneThrown = true;
+	}
+	assert_print(retuneThrown, "Retuning below the width of the notches accepted.\n");
+	assert_print(fabs(harmonics.getFundamental() * fs - 50.4) < 1E-9, "Rejected retuning changed the notches.\n");
+
+	// the adaptive notch steers all harmonics without any trig
+	harmonics.setFundamentalCoefficient(multi.getCoefficient());
+	assert_print(fabs(harmonics.getFundamental() - multi.getFrequency() / fs) < 1E-12,
+		     "Fundamental not taken from the adaptive notch.\n");
+
+	// invalid parameters
+	bool thrown = false;
+	try {
+		notch.setup(fs, 600, 2, 1);
+	} catch (const std::invalid_argument&) {
+		thrown = true;
+	}
+	assert_print(thrown, "Centre frequency above Nyquist accepted.\n");
+	thrown = false;
+	// all ten harmonics of 20Hz are below Nyquist so only MaxHarmonics can reject them
+	harmonics.setup(fs, 20, 9, 2);
+	try {
+		harmonics.setup(fs, 20, 10, 2);
+	} catch (const std::invalid_argument& e) {
+		fprintf(stderr, "Correct exception thrown: %s\n", e.what());
+		thrown = true;
+	}
+	assert_print(thrown, "Too many harmonics accepted.\n");
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+int main(int, char**)
+{
+	// gain of 4
+	const double gain4[1][6] = { { 4, 0, 0, 1, 0, 0 } };
+	Iir::Custom::SOSCascade<1> g4(gain4);
+
+	// saturation of the output
+	Iir::PCMConverter conv16;
+	const int16_t in16[] = { 32767, -32768, 1000, -1000 };
+	int16_t out16[4];
+	Iir::filterPCM(g4, in16, 4, out16, conv16);
+	assert_print(out16[0] == 32767, "No positive saturation.\n");
+	assert_print(out16[1] == -32768, "No negative saturation.\n");
+	assert_print(out16[2] == 4000, "Wrong gain.\n");
+	assert_print(out16[3] == -4000, "Wrong gain.\n");
+
+	// unity gain
+	const double unity[1][6] = { { 1, 0, 0, 1, 0, 0 } };
+	Iir::Custom::SOSCascade<1> g1(unity);
+
+	// 16 bit to 24 bit is exact
+	Iir::PCMConverter conv16to24(16, 24);
+	int32_t out24[4];
+	Iir::filterPCM(g1, in16, 4, out24, conv16to24);
+	for (int i = 0; i < 4; i++) {
+		assert_print(out24[i] == in16[i] * 256, "16 to 24 bit conversion not exact.\n");
+	}
+
+	// 24 bit to 16 bit rounds to the nearest
+	Iir::PCMConverter conv24to16(24, 16);
+	const int32_t in24[] = { 320, 448, -320, -448 };
+	Iir::filterPCM(g1, in24, 4, out16, conv24to16);
+	assert_print(out16[0] == 1, "Wrong rounding.\n");
+	assert_print(out16[1] == 2, "Wrong rounding.\n");
+	assert_print(out16[2] == -1, "Wrong rounding.\n");
+	assert_print(out16[3] == -2, "Wrong rounding.\n");
+
+	// TPDF dither keeps the average of a quarter LSB
+	Iir::PCMConverter dither(24, 16, true);
+	const int n = 100000;
+	double sum = 0;
+	for (int i = 0; i < n; i++) {
+		const int32_t x = 64;
+		int16_t y;
+		Iir::filterPCM(g1, &x, 1, &y, dither);
+		assert_print(abs(y) <= 2, "Dither too large.\n");
+		sum += y;
+	}
+	fprintf(stderr, "Average with dither: %f\n", sum / n);
+	assert_print(fabs(sum / n - 0.25) < 0.01, "Dither is biased.\n");
+
+	// filtering in place
+	Iir::Butterworth::LowPass<4> lp;
+	Iir::Butterworth::LowPass<4> lpRef;
+	lp.setup(48000, 1000);
+	lpRef.setup(48000, 1000);
+	int16_t pcm[1000];
+	for (int i = 0; i < 1000; i++) pcm[i] = (int16_t)(10000 * sin(0.01 * i));
+	int16_t expected[1000];
+	for (int i = 0; i < 1000; i++) expected[i] = (int16_t)lrint(lpRef.filter(pcm[i] / 32768.0) * 32768);
+	Iir::filterPCM(lp, pcm, 1000, pcm, conv16);
+	for (int i = 0; i < 1000; i++) {
+		assert_print(pcm[i] == expected[i], "In-place PCM filtering failed.\n");
+	}
+
+	try {
+		Iir::PCMConverter bad(16, 40);
+		assert_print(0, "No exception thrown for too many bits.");
+	} catch ( const std::invalid_argument& e ) {
+		fprintf(stderr, "Correct exception thrown: %s\n", e.what());
+	}
+
+	return 0;
+}
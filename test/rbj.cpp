@@ -47,5 +47,22 @@ int main(int, char**)
 		}
 	}
 	fprintf(stderr, "%e\n", b);
+	// setGain() needs to give the same filter as a new setup() with that gain
+	Iir::RBJ::LowShelf ls, lsRef;
+	ls.setup(1000, 100, 6);
+	ls.setGain(-12);
+	lsRef.setup(1000, 100, -12);
+	assert_same_response(ls, lsRef, "LowShelf setGain() differs from setup().\n");
+	Iir::RBJ::HighShelf hs, hsRef;
+	hs.setup(1000, 100, 6, 0.5);
+	hs.setGain(3);
+	hsRef.setup(1000, 100, 3, 0.5);
+	assert_same_response(hs, hsRef, "HighShelf setGain() differs from setup().\n");
+	Iir::RBJ::BandShelf bsh, bshRef;
+	bsh.setup(1000, 100, 6, 1);
+	bsh.setGain(-9);
+	bshRef.setup(1000, 100, -9, 1);
+	assert_same_response(bsh, bshRef, "BandShelf setGain() differs from setup().\n");
+
 	return 0;
 }
@@ -0,0 +1,201 @@
+#include "Iir.h"
+
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <math.h>
+
+#include "assert_print.h"
+
+// compares the alternative states against DirectFormI
+template<class Filter, class RefFilter>
+void compare(Filter& f, RefFilter& ref, const char* name) {
+	double maxDiff = 0;
+	double peak = 0;
+	for (int i = 0; i < 20000; i++) {
+		const double x = sin(0.003 * i) + 0.5 * sin(0.2 * i) + ((i % 1000) == 0 ? 1 : 0);
+		const double b = f.filter(x);
+		const double bRef = ref.filter(x);
+		assert_print(!isnan(b), "Output is NAN\n");
+		if (fabs(b - bRef) > maxDiff) maxDiff = fabs(b - bRef);
+		if (fabs(bRef) > peak) peak = fabs(bRef);
+	}
+	fprintf(stderr, "%s: max difference = %e\n", name, maxDiff);
+	assert_print(maxDiff < 1E-9 * (1 + peak), "Output differs from DirectFormI.\n");
+}
+
+template<class StateType>
+void checkState(const char* name) {
+	// ECG baseline removal: 0.1Hz highpass at 1kHz
+	Iir::Butterworth::HighPass<4, StateType> hp;
+	Iir::Butterworth::HighPass<4, Iir::DirectFormI> hpRef;
+	hp.setup(1000, 0.1);
+	hpRef.setup(1000, 0.1);
+	compare(hp, hpRef, name);
+
+	// odd order with a first order section
+	Iir::ChebyshevI::LowPass<5, StateType> lp;
+	Iir::ChebyshevI::LowPass<5, Iir::DirectFormI> lpRef;
+	lp.setup(1000, 20, 1);
+	lpRef.setup(1000, 20, 1);
+	compare(lp, lpRef, name);
+
+	Iir::ChebyshevII::BandStop<4, StateType> bs;
+	Iir::ChebyshevII::BandStop<4, Iir::DirectFormI> bsRef;
+	bs.setup(1000, 50, 5, 40);
+	bsRef.setup(1000, 50, 5, 40);
+	compare(bs, bsRef, name);
+
+	// new coefficients need a new mapping
+	bs.setup(1000, 100, 10, 40);
+	bsRef.setup(1000, 100, 10, 40);
+	bs.reset();
+	bsRef.reset();
+	compare(bs, bsRef, name);
+
+	// the fast gain update of a shelf is mapped as well
+	Iir::Butterworth::LowShelf<4, StateType> ls;
+	Iir::Butterworth::LowShelf<4, Iir::DirectFormI> lsRef;
+	ls.setup(1000, 20, 6);
+	lsRef.setup(1000, 20, 6);
+	ls.setGain(-12);
+	lsRef.setGain(-12);
+	compare(ls, lsRef, name);
+
+	// biquads changed directly are detected until the states are updated
+	Iir::Biquad& b = bs.getCascadeStorage().stageArray[0];
+	b.m_b0 *= 2;
+	b.m_b1 *= 2;
+	b.m_b2 *= 2;
+	assert_print(!bs.getState(0).isMappedFrom(b), "Changed biquad not detected.\n");
+	bs.updateStates();
+	assert_print(bs.getState(0).isMappedFrom(b), "Updated biquad not mapped.\n");
+}
+
+// DirectFormI with float coefficients and delay lines for comparison
+class FloatDirectFormI {
+public:
+	void reset() {
+		m_x1 = m_x2 = m_y1 = m_y2 = 0;
+	}
+
+	double filter(const double in, const Iir::Biquad& s) {
+		const float x = (float)in;
+		const float out = (float)s.m_b0 * x + (float)s.m_b1 * m_x1 + (float)s.m_b2 * m_x2 -
+			(float)s.m_a1 * m_y1 - (float)s.m_a2 * m_y2;
+		m_x2 = m_x1;
+		m_y2 = m_y1;
+		m_x1 = x;
+		m_y1 = out;
+		return out;
+	}
+
+private:
+	float m_x1 = 0;
+	float m_x2 = 0;
+	float m_y1 = 0;
+	float m_y2 = 0;
+};
+
+// relative RMS error of an ECG baseline filter (0.1Hz highpass at 1kHz)
+// against DirectFormII in double precision
+template<class StateType>
+double lowCutoffError() {
+	Iir::Butterworth::HighPass<4, StateType> f;
+	Iir::Butterworth::HighPass<4, Iir::DirectFormII> ref;
+	f.setup(1000, 0.1);
+	ref.setup(1000, 0.1);
+	double sum = 0;
+	double sumRef = 0;
+	const int n = 200000;
+	for (int i = 0; i < n; i++) {
+		const double x = sin(0.0005 * i) + 0.5 * sin(0.2 * i) + 0.1;
+		const double y = f.filter(x);
+		const double yRef = ref.filter(x);
+		sum += (y - yRef) * (y - yRef);
+		sumRef += yRef * yRef;
+	}
+	return sqrt(sum / sumRef);
+}
+
+int main(int, char**)
+{
+	checkState<Iir::StateVariableForm>("StateVariableForm");
+	checkState<Iir::CoupledForm>("CoupledForm");
+	checkState<Iir::LatticeLadder>("LatticeLadder");
+
+	// in float the direct form loses the cutoff, the SVF and coupled form keep it
+	const double eDF = lowCutoffError<FloatDirectFormI>();
+	const double eSVF = lowCutoffError<Iir::StateVariableFormFloat>();
+	const double eCoupled = lowCutoffError<Iir::CoupledFormFloat>();
+	fprintf(stderr, "Float at 0.1Hz/1kHz: DirectFormI = %e, StateVariableForm = %e, CoupledForm = %e\n",
+		eDF, eSVF, eCoupled);
+	assert_print(eSVF < eDF / 100, "Float state variable form not better than the direct form.\n");
+	assert_print(eCoupled < eDF / 100, "Float coupled form not better than the direct form.\n");
+	assert_print(eSVF < 1E-3, "Float state variable form too noisy.\n");
+	assert_print(eCoupled < 1E-3, "Float coupled form too noisy.\n");
+
+	// conversion of a cascade to the lattice form and back
+	Iir::ChebyshevI::BandPass<4> bp;
+	Iir::ChebyshevI::BandPass<4> bpRef;
+	bp.setup(1000, 100, 20, 1);
+	bpRef.setup(1000, 100, 20, 1);
+	Iir::LatticeSection from[4];
+	assert_print(Iir::toLattice(bp.getCascadeStorage(), from), "Bandpass not stable in the lattice form.\n");
+	Iir::fromLattice(from, bp.getCascadeStorage());
+	for (double fr = 0; fr < 0.5; fr += 0.01) {
+		assert_print(abs(bp.response(fr) - bpRef.response(fr)) < 1E-9, "Lattice round trip changes the response.\n");
+	}
+
+	// interpolating between two stable filters stays stable
+	Iir::ChebyshevI::BandPass<4> bp2;
+	bp2.setup(1000, 300, 5, 3);
+	Iir::LatticeSection to[4];
+	Iir::toLattice(bp2.getCascadeStorage(), to);
+	for (double t = 0; t <= 1; t += 0.05) {
+		for (int i = 0; i < 4; i++) {
+			const Iir::LatticeSection s = Iir::LatticeSection::interpolate(from[i], to[i], t);
+			assert_print(s.isStable(), "Interpolated section not stable.\n");
+		}
+	}
+
+	// the lattice coefficients can be set without a round trip through the biquads
+	Iir::ChebyshevI::BandPass<4, Iir::LatticeLadder> bpLattice;
+	Iir::ChebyshevI::BandPass<4, Iir::LatticeLadder> bpMoved;
+	bpLattice.setup(1000, 100, 20, 1);
+	bpMoved.setup(1000, 100, 20, 1);
+	Iir::LatticeSection halfway[4];
+	double sos[4][6];
+	for (int i = 0; i < 4; i++) {
+		halfway[i] = Iir::LatticeSection::interpolate(from[i], to[i], 0.5);
+		Iir::Biquad b;
+		halfway[i].toBiquad(b);
+		sos[i][0] = b.m_b0;
+		sos[i][1] = b.m_b1;
+		sos[i][2] = b.m_b2;
+		sos[i][3] = 1;
+		sos[i][4] = b.m_a1;
+		sos[i][5] = b.m_a2;
+	}
+	Iir::Custom::SOSCascade<4, Iir::DirectFormI> bpDirect(sos);
+	Iir::setLattice(bpLattice, halfway);
+	Iir::fromLattice(halfway, bpMoved.getCascadeStorage());
+	assert_print(!bpMoved.getState(0).isMappedFrom(bpMoved.getCascadeStorage().stageArray[0]),
+		"Biquads written from the lattice not detected.\n");
+	bpMoved.updateStates();
+	double maxDiff = 0;
+	for (int i = 0; i < 2000; i++) {
+		const double x = sin(0.3 * i) + ((i % 500) == 0 ? 1 : 0);
+		const double yRef = bpDirect.filter(x);
+		maxDiff = std::max(maxDiff, fabs(bpLattice.filter(x) - yRef));
+		maxDiff = std::max(maxDiff, fabs(bpMoved.filter(x) - yRef));
+	}
+	assert_print(maxDiff < 1E-9, "Lattice sections not applied.\n");
+	assert_print(bpLattice.getState(0).getSection().k1 == halfway[0].k1, "Section not set.\n");
+
+	// an unstable biquad is detected
+	Iir::Biquad unstable;
+	unstable.setCoefficients(1, -2.1, 1.2, 1, 0, 0);
+	assert_print(!Iir::LatticeSection(unstable).isStable(), "Unstable biquad not detected.\n");
+
+	return 0;
+}